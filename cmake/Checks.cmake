@@ -0,0 +1,61 @@
+# Testy CTest (ctest --test-dir build), uruchamiane jako: cmake -DCHECK=<nazwa> -DBIN=<katalog programów>
+#     -DSOURCE=<katalog źródeł> -DWORK=<katalog roboczy> -P cmake/Checks.cmake
+#
+#     distributed - headless 5 2 42 daje ten sam przebieg w jednym procesie i z --coordinator --workers 3
+#     mapb        - tor .map -> .mapb -> .map -> .mapb, oba pliki .mapb identyczne bajt w bajt (także współrzędne niecałkowite)
+#     snapshot    - trening 6 pokoleń i trening 3 + wznowienie z migawki dają identyczną migawkę końcową
+
+file(MAKE_DIRECTORY ${WORK})
+
+# Uruchamia program i zwraca jego wyjście; błąd kończy test
+function(run_checked out)
+    execute_process(COMMAND ${ARGN} WORKING_DIRECTORY ${WORK} RESULT_VARIABLE result OUTPUT_VARIABLE output ERROR_VARIABLE errors
+                    TIMEOUT 600)
+    if(NOT result EQUAL 0)
+        string(REPLACE ";" " " command "${ARGN}")
+        message(FATAL_ERROR "${command} zakończył się kodem ${result}:\n${output}\n${errors}")
+    endif()
+    set(${out} "${output}" PARENT_SCOPE)
+endfunction()
+
+# Porównuje dwa pliki bajt w bajt
+function(compare_files a b)
+    execute_process(COMMAND ${CMAKE_COMMAND} -E compare_files ${a} ${b} RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Pliki różnią się: ${a} ${b}")
+    endif()
+endfunction()
+
+if(CHECK STREQUAL "distributed")
+    run_checked(single ${BIN}/headless 5 2 42)
+    file(REMOVE ${WORK}/check.sock)
+    run_checked(distributed ${BIN}/headless 5 2 42 --coordinator ${WORK}/check.sock --workers 3)
+    # czas trwania i liczba robotników różnią się między uruchomieniami z definicji
+    foreach(var single distributed)
+        string(REGEX REPLACE "(Robotnicy|Pokoleń): [^\n]*\n" "" ${var} "${${var}}")
+    endforeach()
+    if(NOT single STREQUAL distributed)
+        message(FATAL_ERROR "Ocena rozproszona różni się od jednoprocesowej:\n--- jeden proces\n${single}\n--- rozproszona\n${distributed}")
+    endif()
+elseif(CHECK STREQUAL "mapb")
+    # tor domyślny i tor o współrzędnych niecałkowitych (pełna precyzja zapisu tekstowego)
+    file(WRITE ${WORK}/fractional.map "size 1000.5 999.25\nstart 500.123 900.987\ntarget 500.333 100.777 41.3\n"
+         "obstacle 214.16817 489.8063 110.99284 181.17996\nobstacle 563.14825 58.975971 3.9602661 251.24236\n"
+         "obstacle 0.1 0.2 999.7 0.3\ncheckpoint 700.1 620.3 69.9\ncheckpoint 101.37 430.01 33.333\n")
+    foreach(course ${SOURCE}/maps/default.map ${WORK}/fractional.map)
+        run_checked(ignored ${BIN}/mapconv ${course} first.mapb)
+        run_checked(ignored ${BIN}/mapconv first.mapb roundtrip.map)
+        run_checked(ignored ${BIN}/mapconv roundtrip.map second.mapb)
+        compare_files(${WORK}/first.mapb ${WORK}/second.mapb)
+    endforeach()
+elseif(CHECK STREQUAL "snapshot")
+    set(settings --set population=30 --set lifetime=300 --checkpoint-every 3)
+    file(REMOVE ${WORK}/full.snap ${WORK}/half.snap ${WORK}/resumed.snap)
+    run_checked(ignored ${BIN}/headless 6 1 42 ${settings} --checkpoint full.snap)
+    run_checked(ignored ${BIN}/headless 3 1 42 ${settings} --checkpoint half.snap)
+    # konfiguracja i ziarno pochodzą z migawki
+    run_checked(ignored ${BIN}/headless 6 1 --resume half.snap --checkpoint-every 3 --checkpoint resumed.snap)
+    compare_files(${WORK}/full.snap ${WORK}/resumed.snap)
+else()
+    message(FATAL_ERROR "Nieznany test: ${CHECK}")
+endif()
@@ -0,0 +1,315 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Sensor.h"
+
+// Parametry eksperymentu.
+// Wielkość populacji, ewolucja, długość pokolenia, warstwy ukryte sieci, lasery i fizyka rakiety
+// są ustawiane przy starcie programu z pliku (--config plik.cfg) i/lub z linii poleceń (--set klucz=wartość),
+// więc przegląd hiperparametrów nie wymaga przebudowy. Domyślne wartości to dotychczasowe stałe.
+//
+// Format pliku - jedna komenda na linię, '#' zaczyna komentarz (tak jak w torach .map):
+//     population 100
+//     mutation_rate 5                      # procent mutowanych genów
+//     mutation_strength 0.1
+//     lifetime 2000                        # kroki pokolenia
+//     elite 8                              # najlepsze genotypy przepisywane bez zmian
+//     tournament 5                         # liczba losowań w selekcji turniejowej
+//     hidden 8                             # rozmiary warstw ukrytych, np. "hidden 16 8"
+//     lasers -90 -45 -20 0 20 45 90 180    # kąty laserów względem dzioba w stopniach (maks. MAX_LASERS)
+//     laser_distance 400
+//     gravity 0.02
+//     drag 0.99                            # mnożnik prędkości w każdym kroku (tarcie)
+//     thrust 0.1
+//     rotation_speed 3
+// Sieć ma lasery + 5 wejść (prędkość x/y, dystans i kąt do celu, bias) i 3 wyjścia (obrót w lewo, w prawo, silnik).
+// Opcje nakładają się w kolejności podania, a zakresy sprawdza validateExperiment() raz, po wszystkich
+// (wynik nie zależy od kolejności, np. --set population=4 --set elite=2 i odwrotnie).
+// Konfigurację ustawia się raz, przed utworzeniem populacji - pętle kroku czytają ją bez synchronizacji.
+
+// wejścia sieci poza laserami i liczba wyjść (zob. buildInputs() i applyControls() w Rocket.h)
+const int EXTRA_INPUTS = 5;
+const int NETWORK_OUTPUTS = 3;
+// górna granica liczby warstw ukrytych (sprawdzana też przy odbiorze topologii z sieci i z plików)
+const int MAX_HIDDEN_LAYERS = 16;
+
+struct ExperimentConfig
+{
+    int populationSize = 100;      // ilość rakiet
+    int mutationRate = 5;          // 5%
+    double mutationStrength = 0.1; // 0-1
+    int lifetime = 2000;           // Czas trwania rundy
+    int eliteCount = 8;            // elityzm - zwiększony do 8, aby zachować stabilność
+    int tournamentSize = 5;
+    std::vector<int> hiddenLayers = {8};
+
+    // parametry fizyczne
+    std::vector<float> laserAngles = {-90.f, -45.f, -20.f, 0.f, 20.f, 45.f, 90.f, 180.f};
+    float maxLaserDist = 400.0f;
+    float gravity = 0.02f;
+    float drag = 0.99f;
+    float thrustPower = 0.1f;
+    float rotationSpeed = 3.0f;
+
+    int laserCount() const { return (int)laserAngles.size(); }
+
+    // topologia sieci neuronowej: wejścia, warstwy ukryte, wyjścia (domyślnie 13, 8, 3)
+    std::vector<int> topology() const
+    {
+        std::vector<int> t;
+        t.push_back(laserCount() + EXTRA_INPUTS);
+        t.insert(t.end(), hiddenLayers.begin(), hiddenLayers.end());
+        t.push_back(NETWORK_OUTPUTS);
+        return t;
+    }
+};
+
+// Bieżąca konfiguracja i wartości z niej wyliczane raz (kierunki laserów, topologia)
+struct ExperimentState
+{
+    ExperimentConfig config;
+    LaserRig lasers{config.laserAngles};
+    std::vector<int> topology = config.topology();
+};
+
+inline ExperimentState &experimentState()
+{
+    static ExperimentState state;
+    return state;
+}
+
+inline const ExperimentConfig &experiment() { return experimentState().config; }
+inline const LaserRig &experimentLasers() { return experimentState().lasers; }
+inline const std::vector<int> &experimentTopology() { return experimentState().topology; }
+
+// Ustawia konfigurację - wywoływać na starcie, przed tworzeniem populacji (tak jak setMasterSeed)
+inline void setExperiment(const ExperimentConfig &config)
+{
+    ExperimentState &state = experimentState();
+    state.config = config;
+    state.lasers = LaserRig(config.laserAngles);
+    state.topology = config.topology();
+}
+
+// Sprawdza zakresy wartości; source - nazwa pliku lub opcji w komunikacie błędu
+inline bool validateExperiment(const ExperimentConfig &c, const std::string &source)
+{
+    std::string error;
+    if (c.populationSize < 2)
+        error = "population musi być >= 2";
+    else if (c.mutationRate < 0 || c.mutationRate > 100)
+        error = "mutation_rate musi być z zakresu 0-100";
+    else if (c.mutationStrength < 0.0)
+        error = "mutation_strength musi być >= 0";
+    else if (c.lifetime < 1)
+        error = "lifetime musi być >= 1";
+    else if (c.eliteCount < 0 || c.eliteCount > c.populationSize)
+        error = "elite musi być z zakresu 0-population";
+    else if (c.tournamentSize < 0)
+        error = "tournament musi być >= 0";
+    else if (c.laserAngles.empty() || c.laserCount() > MAX_LASERS)
+        error = "liczba laserów musi być z zakresu 1-" + std::to_string(MAX_LASERS);
+    else if (c.maxLaserDist <= 0.f)
+        error = "laser_distance musi być > 0";
+    if (error.empty() && (int)c.hiddenLayers.size() > MAX_HIDDEN_LAYERS)
+        error = "najwyżej " + std::to_string(MAX_HIDDEN_LAYERS) + " warstw ukrytych";
+    for (int n : c.hiddenLayers)
+        if (error.empty() && n < 1)
+            error = "rozmiary warstw ukrytych muszą być >= 1";
+    if (!error.empty())
+    {
+        std::cerr << source << ": " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Wczytuje wszystkie liczby do końca linii (co najmniej jedną)
+template <class T>
+inline bool readList(std::istringstream &in, std::vector<T> &out)
+{
+    out.clear();
+    T v;
+    while (in >> v)
+        out.push_back(v);
+    return !out.empty() && in.eof();
+}
+
+// Jedna linia pliku konfiguracji ("klucz wartość..."); pusta linia i komentarz są poprawne
+inline bool parseExperimentLine(const std::string &text, ExperimentConfig &c)
+{
+    std::istringstream in(text.substr(0, text.find('#')));
+    std::string key;
+    if (!(in >> key))
+        return true;
+
+    bool ok;
+    if (key == "population")
+        ok = bool(in >> c.populationSize);
+    else if (key == "mutation_rate")
+        ok = bool(in >> c.mutationRate);
+    else if (key == "mutation_strength")
+        ok = bool(in >> c.mutationStrength);
+    else if (key == "lifetime")
+        ok = bool(in >> c.lifetime);
+    else if (key == "elite")
+        ok = bool(in >> c.eliteCount);
+    else if (key == "tournament")
+        ok = bool(in >> c.tournamentSize);
+    else if (key == "hidden") // bez wartości - sieć bez warstw ukrytych
+        ok = readList(in, c.hiddenLayers) || (c.hiddenLayers.empty() && in.eof());
+    else if (key == "lasers")
+        ok = readList(in, c.laserAngles);
+    else if (key == "laser_distance")
+        ok = bool(in >> c.maxLaserDist);
+    else if (key == "gravity")
+        ok = bool(in >> c.gravity);
+    else if (key == "drag")
+        ok = bool(in >> c.drag);
+    else if (key == "thrust")
+        ok = bool(in >> c.thrustPower);
+    else if (key == "rotation_speed")
+        ok = bool(in >> c.rotationSpeed);
+    else
+        ok = false;
+
+    std::string rest;
+    return ok && !(in >> rest);
+}
+
+// Cały tekst konfiguracji (plik albo tekst przesłany przez koordynator, zob. Distributed.h); bez sprawdzania zakresów
+inline bool parseExperiment(const std::string &text, const std::string &name, ExperimentConfig &out)
+{
+    ExperimentConfig c = out;
+    std::istringstream in(text);
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line))
+    {
+        lineNo++;
+        if (!parseExperimentLine(line, c))
+        {
+            std::cerr << name << ":" << lineNo << ": niepoprawna linia: " << line << std::endl;
+            return false;
+        }
+    }
+    out = c;
+    return true;
+}
+
+// Wczytuje plik konfiguracji; klucze, których w nim nie ma, zachowują wartości z out
+inline bool loadExperiment(const std::string &path, ExperimentConfig &out)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Nie można otworzyć konfiguracji: " << path << std::endl;
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return parseExperiment(text.str(), path, out);
+}
+
+// Opcja --set klucz=wartość (lista wartości rozdzielona przecinkami lub spacjami, np. "lasers=-45,0,45")
+inline bool applyExperimentOption(const std::string &option, ExperimentConfig &out)
+{
+    std::string line = option;
+    for (char &ch : line)
+        if (ch == '=' || ch == ',')
+            ch = ' ';
+    ExperimentConfig c = out;
+    if (!parseExperimentLine(line, c) || line.find_first_not_of(' ') == std::string::npos)
+    {
+        std::cerr << "Niepoprawna opcja --set: " << option << std::endl;
+        return false;
+    }
+    out = c;
+    return true;
+}
+
+// Liczba całkowita z argumentu linii poleceń, podniesiona co najmniej do minimum.
+// Zwraca false zamiast rzucać wyjątek (jak std::stoi), gdy tekst nie jest w całości liczbą albo nie mieści się w T
+template <class T>
+inline bool parseNumber(const std::string &text, T &out, T minimum = std::numeric_limits<T>::lowest())
+{
+    static_assert(std::is_integral<T>::value, "parseNumber obsługuje liczby całkowite");
+    size_t used = 0;
+    try
+    {
+        if (std::is_unsigned<T>::value)
+        {
+            // stoull przyjmuje "-1" i zawija go do maksimum - tu to błąd
+            if (text.find('-') != std::string::npos)
+                return false;
+            unsigned long long v = std::stoull(text, &used, 10);
+            if (used != text.size() || v > (unsigned long long)std::numeric_limits<T>::max())
+                return false;
+            out = std::max(minimum, (T)v);
+        }
+        else
+        {
+            long long v = std::stoll(text, &used, 10);
+            if (used != text.size() || v < (long long)std::numeric_limits<T>::lowest() || v > (long long)std::numeric_limits<T>::max())
+                return false;
+            out = std::max(minimum, (T)v);
+        }
+    }
+    catch (const std::logic_error &) // std::invalid_argument, std::out_of_range
+    {
+        return false;
+    }
+    return true;
+}
+
+// Najkrótszy zapis liczby, z którego operator >> odtwarza dokładnie tę samą wartość typu T
+template <class T>
+inline std::string formatExact(T value)
+{
+    for (int precision = 6;; ++precision)
+    {
+        std::ostringstream out;
+        out << std::setprecision(precision) << value;
+        std::istringstream in(out.str());
+        T back;
+        if ((in >> back && back == value) || precision >= std::numeric_limits<T>::max_digits10)
+            return out.str();
+    }
+}
+
+// Zapis w formacie pliku konfiguracji; parseExperiment() odtwarza z niego dokładnie te same wartości
+inline std::string formatExperiment(const ExperimentConfig &c)
+{
+    std::ostringstream out;
+    out << "population " << c.populationSize << "\n";
+    out << "mutation_rate " << c.mutationRate << "\n";
+    out << "mutation_strength " << formatExact(c.mutationStrength) << "\n";
+    out << "lifetime " << c.lifetime << "\n";
+    out << "elite " << c.eliteCount << "\n";
+    out << "tournament " << c.tournamentSize << "\n";
+    out << "hidden";
+    for (int n : c.hiddenLayers)
+        out << " " << n;
+    out << "\nlasers";
+    for (float a : c.laserAngles)
+        out << " " << formatExact(a);
+    out << "\nlaser_distance " << formatExact(c.maxLaserDist) << "\n";
+    out << "gravity " << formatExact(c.gravity) << "\n";
+    out << "drag " << formatExact(c.drag) << "\n";
+    out << "thrust " << formatExact(c.thrustPower) << "\n";
+    out << "rotation_speed " << formatExact(c.rotationSpeed) << "\n";
+    return out.str();
+}
+
+#endif // CONFIG_H
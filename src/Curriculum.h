@@ -0,0 +1,227 @@
+#ifndef CURRICULUM_H
+#define CURRICULUM_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "World.h"
+#include "Population.h"
+#include "Rocket.h"
+#include "GeneticAlgorithm.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include "Random.h"
+#include "Profiler.h"
+
+// Ocena na wielu scenariuszach (curriculum).
+// Każdy genotyp lata w K scenariuszach (tor x pozycja startowa) i dostaje zagregowany fitness
+// (średnia, minimum albo percentyl), więc ewolucja nagradza sieci, które radzą sobie na wielu torach,
+// a nie jedną wyuczoną trasę. Wszystkie K * N epizodów to jedna populacja epizodów: epizod k * N + i
+// to genotyp i w scenariuszu k. Porcje kroku nie przekraczają granic scenariuszy, a pula wątków
+// rozdziela porcje wszystkich scenariuszy naraz, więc zajęte są wszystkie rdzenie.
+
+// Scenariusz oceny: tor i pozycja startowa
+struct Scenario
+{
+    const World *world = nullptr;
+    sf::Vector2f start;
+};
+
+// sposób łączenia wyników genotypu z K scenariuszy
+enum class FitnessAggregate
+{
+    Mean,
+    Min,
+    Percentile
+};
+
+struct Curriculum
+{
+    std::vector<const World *> maps; // tory oceny (muszą żyć dłużej niż Curriculum)
+    int startsPerMap = 1;            // 1 = tylko startPos toru, więcej = dodatkowe losowe starty w pobliżu
+    float startJitter = 60.f;        // maks. przesunięcie losowego startu w każdej osi
+    FitnessAggregate aggregate = FitnessAggregate::Mean;
+    double percentile = 25.0; // dla FitnessAggregate::Percentile, 0 = najgorszy wynik
+    EarlyStop earlyStop;      // reguły wcześniejszego końca pokolenia (wspólne dla wszystkich scenariuszy)
+
+    // scenariusze bieżącego pokolenia (losowe starty losowane co pokolenie)
+    std::vector<Scenario> scenarios;
+    // stan wszystkich epizodów [scenariusz * N + genotyp]
+    Population episodes;
+    std::vector<double> scores; // bufor wyników jednego genotypu
+
+    int scenarioCount() const { return (int)maps.size() * startsPerMap; }
+};
+
+// Rozpoznaje sposób agregacji: "mean", "min" albo "pNN" (percentyl NN)
+inline bool parseAggregate(const std::string &text, FitnessAggregate &aggregate, double &percentile)
+{
+    if (text == "mean")
+        aggregate = FitnessAggregate::Mean;
+    else if (text == "min")
+        aggregate = FitnessAggregate::Min;
+    else if (text.size() > 1 && text[0] == 'p')
+    {
+        char *end = nullptr;
+        double p = std::strtod(text.c_str() + 1, &end);
+        if (*end != '\0' || p < 0.0 || p > 100.0)
+            return false;
+        aggregate = FitnessAggregate::Percentile;
+        percentile = p;
+    }
+    else
+        return false;
+    return true;
+}
+
+// Czy rakieta ustawiona pionowo w punkcie start nie koliduje z przeszkodami ani granicami toru
+inline bool isFreeStart(const World &world, sf::Vector2f start)
+{
+    Box bounds = {start.x - SHIP_WIDTH / 2.f, start.y - SHIP_HEIGHT / 2.f, start.x + SHIP_WIDTH / 2.f, start.y + SHIP_HEIGHT / 2.f};
+    if (bounds.minX < 0.f || bounds.minY < 0.f || bounds.maxX > world.width || bounds.maxY > world.height)
+        return false;
+    for (const Box &b : world.przeszkody)
+        if (boxesIntersect(bounds, b))
+            return false;
+    return true;
+}
+
+// Ustala scenariusze pokolenia. Pierwszy start każdego toru to jego startPos, kolejne są losowane
+// wokół niego z własnego strumienia (ziarno, pokolenie, scenariusz) - ten sam przebieg dla tego samego ziarna
+inline void prepareScenarios(Curriculum &cur, std::uint64_t seed, int generation)
+{
+    cur.scenarios.clear();
+    for (const World *world : cur.maps)
+    {
+        for (int s = 0; s < cur.startsPerMap; ++s)
+        {
+            Scenario sc;
+            sc.world = world;
+            sc.start = world->startPos;
+            if (s > 0)
+            {
+                Rng rng = Rng::stream(seed, STREAM_CURRICULUM, ((std::uint64_t)generation << 32) | (std::uint32_t)cur.scenarios.size());
+                // kilka prób trafienia w wolne miejsce, w razie niepowodzenia zostaje startPos
+                for (int attempt = 0; attempt < 32; ++attempt)
+                {
+                    sf::Vector2f p = {world->startPos.x + (float)rng.range(-cur.startJitter, cur.startJitter),
+                                      world->startPos.y + (float)rng.range(-cur.startJitter, cur.startJitter)};
+                    if (isFreeStart(*world, p))
+                    {
+                        sc.start = p;
+                        break;
+                    }
+                }
+            }
+            cur.scenarios.push_back(sc);
+        }
+    }
+}
+
+// łączy wyniki genotypu z wszystkich scenariuszy (kolejność values może się zmienić)
+inline double aggregateScores(std::vector<double> &values, FitnessAggregate aggregate, double percentile)
+{
+    if (aggregate == FitnessAggregate::Min)
+        return *std::min_element(values.begin(), values.end());
+    if (aggregate == FitnessAggregate::Percentile)
+    {
+        // percentyl metodą najbliższej pozycji
+        size_t k = (size_t)std::lround(percentile / 100.0 * (double)(values.size() - 1));
+        std::nth_element(values.begin(), values.begin() + k, values.end());
+        return values[k];
+    }
+    double sum = 0.0;
+    for (double v : values)
+        sum += v;
+    return sum / (double)values.size();
+}
+
+// Symuluje całe pokolenie we wszystkich scenariuszach i wpisuje zagregowany fitness do pop.fitness.
+// Statystyki: maks. i suma zagregowanego fitnessu, liczba genotypów, które ukończyły wszystkie scenariusze,
+// maks. liczba checkpointów w dowolnym epizodzie
+inline GenerationStats runCurriculum(Curriculum &cur, Population &pop, std::uint64_t seed, int generation, ThreadPool *pool = nullptr)
+{
+    prepareScenarios(cur, seed, generation);
+    const int k = (int)cur.scenarios.size();
+    const int n = pop.size;
+
+    Population &ep = cur.episodes;
+    if (ep.size != k * n || ep.genomeSize != pop.genomeSize)
+        ep.resize(k * n, pop.laserCount, pop.topology);
+    cur.scores.resize(k);
+
+    // kopia genotypów do każdego scenariusza - koszt pomijalny wobec lifetime kroków sieci
+    for (int s = 0; s < k; ++s)
+    {
+        std::copy(pop.genomes.begin(), pop.genomes.end(), ep.genomes.begin() + (size_t)s * n * pop.genomeSize);
+        for (int i = 0; i < n; ++i)
+            ep.reset(s * n + i, cur.scenarios[s].start);
+    }
+    // porcje po STEP_GRAIN epizodów w obrębie jednego scenariusza
+    ep.activateAll(n);
+
+    auto stepChunks = [&](int cb, int ce)
+    {
+        StepResult part;
+        for (int c = cb; c < ce; ++c)
+            part.add(stepChunk(ep, *cur.scenarios[ep.chunkBegin[c] / n].world, c));
+        return part;
+    };
+
+    EarlyStopMonitor stopMonitor;
+    const int lifetime = experiment().lifetime;
+    int steps = 0;
+    for (int timer = 0; timer <= lifetime; ++timer)
+    {
+        StepResult step;
+        if (pool)
+        {
+            StepAccumulator acc;
+            pool->parallelFor(0, ep.chunkCount(), 1, [&](int b, int e)
+                              { acc.add(stepChunks(b, e)); });
+            step = acc.result();
+        }
+        else
+            step = stepChunks(0, ep.chunkCount());
+        PROFILE_TICK();
+        if (step.active == 0)
+            break;
+        steps++;
+        if (stopMonitor.update(cur.earlyStop, step))
+            break;
+    }
+
+    GenerationStats stats;
+    stats.steps = steps;
+    PROFILE_SCOPE(Phase::Fitness, (std::uint64_t)k * n);
+    for (int s = 0; s < k; ++s)
+        for (int i = 0; i < n; ++i)
+            calcFitness(ep, s * n + i, *cur.scenarios[s].world, cur.scenarios[s].start, lifetime);
+
+    for (int i = 0; i < n; ++i)
+    {
+        bool completedAll = true;
+        for (int s = 0; s < k; ++s)
+        {
+            int e = s * n + i;
+            cur.scores[s] = ep.fitness[e];
+            completedAll = completedAll && ep.completed[e];
+            stats.maxCheckpoints = std::max(stats.maxCheckpoints, ep.checkpointsVisited(e));
+        }
+        pop.fitness[i] = aggregateScores(cur.scores, cur.aggregate, cur.percentile);
+
+        if (pop.fitness[i] > stats.maxFit)
+            stats.maxFit = pop.fitness[i];
+        stats.sumFit += pop.fitness[i];
+        if (completedAll)
+            stats.completedCount++;
+    }
+    return stats;
+}
+
+#endif // CURRICULUM_H
@@ -0,0 +1,803 @@
+#ifndef DISTRIBUTED_H
+#define DISTRIBUTED_H
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "World.h"
+#include "Population.h"
+#include "Rocket.h"
+#include "GeneticAlgorithm.h"
+#include "Curriculum.h"
+#include "MapLoader.h"
+#include "Metrics.h"
+#include "ThreadPool.h"
+#include "Config.h"
+
+// Ocena rozproszona między procesy (tylko POSIX).
+// Koordynator (headless --coordinator) trzyma stan algorytmu genetycznego i co pokolenie dzieli populację na partie
+// genotypów, które wysyła procesom roboczym (headless --worker). Robotnik ocenia partię tak samo jak runCurriculum()
+// (te same scenariusze z ziarna i numeru pokolenia) i odsyła fitness oraz wynik każdego lotu. Wynik genotypu nie
+// zależy od partii, więc przebieg rozproszony jest identyczny z jednoprocesowym (poza regułami EarlyStop,
+// które działają w obrębie partii). Każdy robotnik ma naraz PIPELINE_DEPTH partii, więc po odesłaniu wyniku
+// od razu liczy następną.
+// Połączenie: gniazdo uniksowe (ścieżka) albo TCP ("host:port"). Wiadomości little-endian:
+//     MessageHeader, potem header.size bajtów treści
+//     Hello  - HelloMessage, int32 topology[layerCount], dla każdego toru: uint64 rozmiar + tor binarny (MapLoader.h),
+//              uint64 rozmiar + tekst konfiguracji eksperymentu (Config.h) - robotnik nie potrzebuje własnej
+//     Batch  - BatchMessage, Real genomes[count * genomeSize]
+//     Result - ResultMessage, double fitness[count], a dla lotów [scenariusz * count + i]:
+//              uint32 visited[], int32 timeAlive[], uint8 completed[]
+//     Stop   - bez treści
+
+const char DIST_MAGIC[4] = {'R', 'D', 'S', 'T'};
+const std::uint32_t DIST_VERSION = 2;
+// liczba partii wysłanych naraz do jednego robotnika
+const int PIPELINE_DEPTH = 2;
+// domyślna liczba genotypów w partii
+const int DEFAULT_BATCH_SIZE = 16;
+// co ile koordynator czekający na robotników sprawdza, czy lokalne procesy robocze jeszcze żyją
+const int ACCEPT_POLL_MS = 200;
+
+#ifdef MSG_NOSIGNAL
+const int DIST_SEND_FLAGS = MSG_NOSIGNAL;
+#else
+const int DIST_SEND_FLAGS = 0;
+#endif
+
+// Zerwane połączenie ma być błędem send(), a nie sygnałem SIGPIPE kończącym proces
+// (macOS nie ma MSG_NOSIGNAL - tam SO_NOSIGPIPE na gnieździe i ignorowany SIGPIPE)
+inline void ignoreBrokenPipe(int fd = -1)
+{
+    signal(SIGPIPE, SIG_IGN);
+#ifdef SO_NOSIGPIPE
+    if (fd >= 0)
+    {
+        int one = 1;
+        setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+    }
+#else
+    (void)fd;
+#endif
+}
+
+enum class MessageType : std::uint32_t
+{
+    Hello = 1,
+    Batch = 2,
+    Result = 3,
+    Stop = 4
+};
+
+struct MessageHeader
+{
+    char magic[4];
+    std::uint32_t type;
+    std::uint64_t size;
+};
+static_assert(sizeof(MessageHeader) == 16, "MessageHeader musi mieć stały rozmiar");
+
+struct HelloMessage
+{
+    std::uint32_t version;
+    std::uint32_t realBytes; // sizeof(Real) - obie strony muszą liczyć w tej samej precyzji
+    std::uint64_t seed;
+    std::int32_t genomeSize;
+    std::int32_t layerCount;
+    std::int32_t laserCount;
+    std::int32_t lifetime;
+    std::int32_t startsPerMap;
+    float startJitter;
+    std::int32_t aggregate;
+    std::int32_t mapCount;
+    double percentile;
+    std::int32_t stallTicks;
+    std::int32_t allStuck;
+};
+static_assert(sizeof(HelloMessage) == 64, "HelloMessage musi mieć stały rozmiar");
+
+struct BatchMessage
+{
+    std::int32_t generation;
+    std::int32_t first; // numer pierwszego genotypu partii w populacji koordynatora
+    std::int32_t count;
+    std::int32_t reserved;
+};
+static_assert(sizeof(BatchMessage) == 16, "BatchMessage musi mieć stały rozmiar");
+
+struct ResultMessage
+{
+    std::int32_t first;
+    std::int32_t count;
+    std::int32_t scenarios;
+    std::int32_t steps;
+};
+static_assert(sizeof(ResultMessage) == 16, "ResultMessage musi mieć stały rozmiar");
+
+// --- gniazda ---
+
+inline bool sendAll(int fd, const void *data, size_t size)
+{
+    const char *p = static_cast<const char *>(data);
+    while (size > 0)
+    {
+        ssize_t n = ::send(fd, p, size, DIST_SEND_FLAGS);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+inline bool recvAll(int fd, void *data, size_t size)
+{
+    char *p = static_cast<char *>(data);
+    while (size > 0)
+    {
+        ssize_t n = ::recv(fd, p, size, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return false;
+        p += n;
+        size -= (size_t)n;
+    }
+    return true;
+}
+
+// Wysyła wiadomość złożoną z dwóch części treści (np. nagłówek partii i genotypy) bez kopiowania ich do jednego bufora
+inline bool sendMessage(int fd, MessageType type, const void *part1, size_t size1, const void *part2 = nullptr, size_t size2 = 0)
+{
+    MessageHeader h;
+    std::memcpy(h.magic, DIST_MAGIC, 4);
+    h.type = (std::uint32_t)type;
+    h.size = size1 + size2;
+    return sendAll(fd, &h, sizeof(h)) && (size1 == 0 || sendAll(fd, part1, size1)) && (size2 == 0 || sendAll(fd, part2, size2));
+}
+
+inline bool recvMessage(int fd, MessageType &type, std::vector<char> &payload)
+{
+    MessageHeader h;
+    if (!recvAll(fd, &h, sizeof(h)))
+        return false;
+    if (std::memcmp(h.magic, DIST_MAGIC, 4) != 0 || h.size > (1ull << 32))
+    {
+        std::cerr << "Nieprawidłowa wiadomość od drugiej strony połączenia" << std::endl;
+        return false;
+    }
+    type = (MessageType)h.type;
+    payload.resize((size_t)h.size);
+    return h.size == 0 || recvAll(fd, payload.data(), payload.size());
+}
+
+// "host:port" oznacza TCP, wszystko inne - ścieżkę gniazda uniksowego
+inline bool isTcpAddress(const std::string &address, std::string &host, std::string &port)
+{
+    size_t colon = address.rfind(':');
+    if (colon == std::string::npos || address.find('/') != std::string::npos)
+        return false;
+    host = address.substr(0, colon);
+    port = address.substr(colon + 1);
+    return !port.empty();
+}
+
+inline int openSocket(const std::string &address, bool listening)
+{
+    std::string host, port;
+    if (isTcpAddress(address, host, port))
+    {
+        addrinfo hints;
+        std::memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = listening ? AI_PASSIVE : 0;
+        addrinfo *list = nullptr;
+        if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &list) != 0)
+            return -1;
+        int fd = -1;
+        for (addrinfo *ai = list; ai && fd < 0; ai = ai->ai_next)
+        {
+            fd = ::socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+            if (fd < 0)
+                continue;
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            if (listening)
+                setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+            bool ok = listening ? ::bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 && ::listen(fd, 64) == 0
+                                : ::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0;
+            if (!ok)
+            {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+        freeaddrinfo(list);
+        return fd;
+    }
+
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (address.size() >= sizeof(addr.sun_path))
+        return -1;
+    std::memcpy(addr.sun_path, address.c_str(), address.size());
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    bool ok;
+    if (listening)
+    {
+        ::unlink(address.c_str());
+        ok = ::bind(fd, (sockaddr *)&addr, sizeof(addr)) == 0 && ::listen(fd, 64) == 0;
+    }
+    else
+        ok = ::connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0;
+    if (!ok)
+    {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// --- proces roboczy ---
+
+// Łączy się z koordynatorem, ocenia otrzymane partie (threads wątków, 0 = wszystkie rdzenie) i odsyła wyniki
+// aż do wiadomości Stop
+inline int runWorker(const std::string &address, int threads)
+{
+    // koordynator może jeszcze nie nasłuchiwać - kilka prób przez ok. 10 s
+    int fd = -1;
+    for (int attempt = 0; attempt < 200 && fd < 0; ++attempt)
+    {
+        fd = openSocket(address, false);
+        if (fd < 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    if (fd < 0)
+    {
+        std::cerr << "Nie można połączyć z koordynatorem: " << address << std::endl;
+        return 1;
+    }
+    ignoreBrokenPipe(fd);
+
+    MessageType type;
+    std::vector<char> payload;
+    HelloMessage hello;
+    if (!recvMessage(fd, type, payload) || type != MessageType::Hello || payload.size() < sizeof(hello))
+    {
+        std::cerr << "Brak konfiguracji od koordynatora" << std::endl;
+        ::close(fd);
+        return 1;
+    }
+    std::memcpy(&hello, payload.data(), sizeof(hello));
+    if (hello.version != DIST_VERSION || hello.realBytes != sizeof(Real))
+    {
+        std::cerr << "Koordynator nie pasuje do tego programu (wersja protokołu lub precyzja)" << std::endl;
+        ::close(fd);
+        return 1;
+    }
+
+    // każde pole czytane tylko po sprawdzeniu, ile bajtów zostało (bez wskaźników za końcem bufora)
+    const char *p = payload.data() + sizeof(hello);
+    size_t left = payload.size() - sizeof(hello);
+    if (hello.layerCount < 2 || hello.layerCount > MAX_HIDDEN_LAYERS + 2 || (size_t)hello.layerCount > left / sizeof(std::int32_t) ||
+        hello.mapCount < 1 || (size_t)hello.mapCount > left / sizeof(std::uint64_t))
+    {
+        std::cerr << "Uszkodzona konfiguracja koordynatora" << std::endl;
+        ::close(fd);
+        return 1;
+    }
+    std::vector<int> topology(hello.layerCount);
+    for (int &layer : topology)
+    {
+        std::int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        left -= sizeof(v);
+        layer = v;
+    }
+
+    std::vector<World> worlds(hello.mapCount);
+    for (int m = 0; m < hello.mapCount; ++m)
+    {
+        std::uint64_t size = 0;
+        if (left >= sizeof(size))
+        {
+            std::memcpy(&size, p, sizeof(size));
+            p += sizeof(size);
+            left -= sizeof(size);
+        }
+        if (size == 0 || size > left)
+        {
+            std::cerr << "Uszkodzona konfiguracja koordynatora" << std::endl;
+            ::close(fd);
+            return 1;
+        }
+        std::vector<char> blob(p, p + size);
+        p += size;
+        left -= size;
+        if (!parseMapBinary(blob, "tor " + std::to_string(m), worlds[m]))
+        {
+            ::close(fd);
+            return 1;
+        }
+    }
+
+    std::uint64_t configSize = 0;
+    if (left >= sizeof(configSize))
+    {
+        std::memcpy(&configSize, p, sizeof(configSize));
+        p += sizeof(configSize);
+        left -= sizeof(configSize);
+    }
+    const char *end = payload.data() + payload.size();
+    ExperimentConfig config;
+    if (configSize != left || !parseExperiment(std::string(p, end), "konfiguracja koordynatora", config) ||
+        !validateExperiment(config, "konfiguracja koordynatora"))
+    {
+        ::close(fd);
+        return 1;
+    }
+    setExperiment(config);
+    if (topology != experimentTopology() || hello.laserCount != config.laserCount() || hello.lifetime != config.lifetime ||
+        hello.genomeSize != FlatNetwork::weightCount(topology))
+    {
+        std::cerr << "Uszkodzona konfiguracja koordynatora" << std::endl;
+        ::close(fd);
+        return 1;
+    }
+
+    Curriculum cur;
+    for (const World &w : worlds)
+        cur.maps.push_back(&w);
+    cur.startsPerMap = hello.startsPerMap;
+    cur.startJitter = hello.startJitter;
+    cur.aggregate = (FitnessAggregate)hello.aggregate;
+    cur.percentile = hello.percentile;
+    cur.earlyStop.stallTicks = hello.stallTicks;
+    cur.earlyStop.allStuck = hello.allStuck != 0;
+
+    ThreadPool pool(threads);
+    Population pop;
+    std::vector<char> result;
+    while (recvMessage(fd, type, payload))
+    {
+        if (type == MessageType::Stop)
+            break;
+        BatchMessage batch;
+        if (type != MessageType::Batch || payload.size() < sizeof(batch))
+            break;
+        std::memcpy(&batch, payload.data(), sizeof(batch));
+        if (batch.count <= 0 || payload.size() != sizeof(batch) + (size_t)batch.count * hello.genomeSize * sizeof(Real))
+            break;
+
+        if (pop.size != batch.count)
+            pop.resize(batch.count, hello.laserCount, topology);
+        std::memcpy(pop.genomes.data(), payload.data() + sizeof(batch), (size_t)batch.count * hello.genomeSize * sizeof(Real));
+
+        GenerationStats stats = runCurriculum(cur, pop, hello.seed, batch.generation, &pool);
+
+        // wynik: fitness genotypów i stan końcowy każdego lotu
+        const Population &ep = cur.episodes;
+        ResultMessage r;
+        r.first = batch.first;
+        r.count = batch.count;
+        r.scenarios = cur.scenarioCount();
+        r.steps = stats.steps;
+        const size_t flights = (size_t)ep.size;
+        result.resize(sizeof(r) + batch.count * sizeof(double) + flights * (sizeof(std::uint32_t) + sizeof(std::int32_t) + 1));
+        char *q = result.data();
+        std::memcpy(q, &r, sizeof(r));
+        q += sizeof(r);
+        std::memcpy(q, pop.fitness.data(), batch.count * sizeof(double));
+        q += batch.count * sizeof(double);
+        std::memcpy(q, ep.visitedCheckpoints.data(), flights * sizeof(std::uint32_t));
+        q += flights * sizeof(std::uint32_t);
+        for (size_t e = 0; e < flights; ++e)
+        {
+            std::int32_t t = ep.timeAlive[e];
+            std::memcpy(q, &t, sizeof(t));
+            q += sizeof(t);
+        }
+        std::memcpy(q, ep.completed.data(), flights);
+        if (!sendMessage(fd, MessageType::Result, result.data(), result.size()))
+            break;
+    }
+    ::close(fd);
+    return 0;
+}
+
+// --- koordynator ---
+
+class DistributedEvaluator
+{
+public:
+    DistributedEvaluator() = default;
+    DistributedEvaluator(const DistributedEvaluator &) = delete;
+    DistributedEvaluator &operator=(const DistributedEvaluator &) = delete;
+
+    ~DistributedEvaluator() { stop(); }
+
+    // Nasłuchuje pod address, uruchamia localWorkers jednowątkowych procesów roboczych (program z --worker,
+    // zwykle argv[0] koordynatora) i czeka na połączenie localWorkers + remoteWorkers robotników; każdy dostaje
+    // konfigurację oceny. false, gdy lokalny proces roboczy zakończy się przed połączeniem
+    bool start(const std::string &program, const std::string &address, int localWorkers, int remoteWorkers, const Curriculum &cur,
+               std::uint64_t seed, int batchSize)
+    {
+        ignoreBrokenPipe();
+        this->batchSize = std::max(1, batchSize);
+        this->scenarios = cur.scenarioCount();
+        this->address = address;
+        listenFd = openSocket(address, true);
+        if (listenFd < 0)
+        {
+            std::cerr << "Nie można nasłuchiwać pod adresem: " << address << std::endl;
+            return false;
+        }
+
+        for (int w = 0; w < localWorkers; ++w)
+        {
+            pid_t pid = fork();
+            if (pid == 0)
+            {
+                ::close(listenFd);
+                const char *args[] = {program.c_str(), "--worker", address.c_str(), "1", nullptr};
+                execvp(program.c_str(), const_cast<char *const *>(args));
+                std::cerr << "Nie można uruchomić procesu roboczego: " << program << std::endl;
+                _exit(127);
+            }
+            if (pid < 0)
+            {
+                std::cerr << "Nie można utworzyć procesu roboczego" << std::endl;
+                killChildren();
+                return false;
+            }
+            children.push_back(pid);
+        }
+
+        std::vector<char> hello;
+        buildHello(hello, cur, seed);
+        const int total = localWorkers + remoteWorkers;
+        while ((int)workers.size() < total)
+        {
+            // accept() tylko wtedy, gdy ktoś czeka - w międzyczasie sprawdzamy, czy lokalni robotnicy żyją
+            pollfd pfd = {listenFd, POLLIN, 0};
+            int ready = ::poll(&pfd, 1, ACCEPT_POLL_MS);
+            if (ready < 0 && errno != EINTR)
+            {
+                std::cerr << "Błąd przy oczekiwaniu na robotników" << std::endl;
+                killChildren();
+                return false;
+            }
+            if (ready <= 0)
+            {
+                if (childExited())
+                {
+                    std::cerr << "Proces roboczy zakończył się przed połączeniem z koordynatorem" << std::endl;
+                    killChildren();
+                    return false;
+                }
+                continue;
+            }
+
+            int fd = ::accept(listenFd, nullptr, nullptr);
+            if (fd < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == ECONNABORTED)
+                    continue;
+                std::cerr << "Błąd przy przyjmowaniu robotnika" << std::endl;
+                killChildren();
+                return false;
+            }
+            ignoreBrokenPipe(fd);
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+            if (!sendMessage(fd, MessageType::Hello, hello.data(), hello.size()))
+            {
+                ::close(fd);
+                continue;
+            }
+            workers.push_back({fd, {}});
+        }
+        return !workers.empty();
+    }
+
+    // Ocenia pokolenie: wpisuje fitness do pop.fitness, stan końcowy lotów do flights() i zwraca statystyki
+    // (te same co runCurriculum). false, gdy nie został żaden działający robotnik
+    bool evaluate(Population &pop, int generation, GenerationStats &stats)
+    {
+        const int n = pop.size;
+        if (flightState.size != scenarios * n || flightState.genomeSize != pop.genomeSize)
+            flightState.resize(scenarios * n, pop.laserCount, pop.topology);
+
+        pending.clear();
+        for (int first = 0; first < n; first += batchSize)
+            pending.push_back({first, std::min(batchSize, n - first)});
+        int outstanding = (int)pending.size();
+        steps = 0;
+
+        for (Worker &w : workers)
+            fillPipeline(w, pop, generation);
+        removeDropped();
+
+        std::vector<pollfd> fds;
+        while (outstanding > 0)
+        {
+            fds.clear();
+            for (Worker &w : workers)
+                fds.push_back({w.fd, POLLIN, 0});
+            if (fds.empty())
+            {
+                std::cerr << "Brak działających robotników" << std::endl;
+                return false;
+            }
+            if (::poll(fds.data(), fds.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+
+            // fds[k] to workers[k] - robotnicy rozłączeni w tej pętli są tylko oznaczani (fd = -1)
+            // i usuwani z listy dopiero po niej, więc indeksy i referencje pozostają ważne
+            for (size_t k = 0; k < fds.size(); ++k)
+            {
+                Worker &w = workers[k];
+                if (w.fd < 0 || !(fds[k].revents & (POLLIN | POLLHUP | POLLERR)))
+                    continue;
+                MessageType type;
+                if (!recvMessage(w.fd, type, payload) || type != MessageType::Result || !storeResult(pop, w))
+                {
+                    dropWorker(w);
+                    continue;
+                }
+                outstanding--;
+                fillPipeline(w, pop, generation);
+            }
+            // partie robotników, którzy się rozłączyli, trafiają do pozostałych
+            for (Worker &w : workers)
+                fillPipeline(w, pop, generation);
+            removeDropped();
+        }
+
+        // statystyki w kolejności genotypów - tak samo jak w runCurriculum()
+        stats = GenerationStats();
+        stats.steps = steps;
+        for (int i = 0; i < n; ++i)
+        {
+            bool completedAll = true;
+            for (int s = 0; s < scenarios; ++s)
+            {
+                int e = s * n + i;
+                completedAll = completedAll && flightState.completed[e];
+                stats.maxCheckpoints = std::max(stats.maxCheckpoints, flightState.checkpointsVisited(e));
+            }
+            if (pop.fitness[i] > stats.maxFit)
+                stats.maxFit = pop.fitness[i];
+            stats.sumFit += pop.fitness[i];
+            if (completedAll)
+                stats.completedCount++;
+        }
+        return true;
+    }
+
+    // Stan końcowy lotów ostatniego pokolenia [scenariusz * N + genotyp] (do statystyk)
+    const Population &flights() const { return flightState; }
+
+    int workerCount() const { return (int)workers.size(); }
+
+    // Kończy pracę robotników i czeka na procesy uruchomione lokalnie
+    void stop()
+    {
+        for (Worker &w : workers)
+        {
+            sendMessage(w.fd, MessageType::Stop, nullptr, 0);
+            ::close(w.fd);
+        }
+        workers.clear();
+        if (listenFd >= 0)
+        {
+            ::close(listenFd);
+            listenFd = -1;
+            std::string host, port;
+            if (!isTcpAddress(address, host, port))
+                ::unlink(address.c_str());
+        }
+        for (pid_t pid : children)
+            waitpid(pid, nullptr, 0);
+        children.clear();
+    }
+
+private:
+    struct Range
+    {
+        int first;
+        int count;
+    };
+
+    struct Worker
+    {
+        int fd;
+        std::deque<Range> inFlight;
+    };
+
+    void buildHello(std::vector<char> &out, const Curriculum &cur, std::uint64_t seed)
+    {
+        HelloMessage h;
+        std::memset(&h, 0, sizeof(h));
+        h.version = DIST_VERSION;
+        h.realBytes = sizeof(Real);
+        h.seed = seed;
+        const std::vector<int> &topology = experimentTopology();
+        h.genomeSize = FlatNetwork::weightCount(topology);
+        h.layerCount = (std::int32_t)topology.size();
+        h.laserCount = (std::int32_t)experiment().laserCount();
+        h.lifetime = experiment().lifetime;
+        h.startsPerMap = cur.startsPerMap;
+        h.startJitter = cur.startJitter;
+        h.aggregate = (std::int32_t)cur.aggregate;
+        h.mapCount = (std::int32_t)cur.maps.size();
+        h.percentile = cur.percentile;
+        h.stallTicks = cur.earlyStop.stallTicks;
+        h.allStuck = cur.earlyStop.allStuck;
+
+        out.assign((const char *)&h, (const char *)&h + sizeof(h));
+        for (int layer : topology)
+        {
+            std::int32_t v = layer;
+            out.insert(out.end(), (const char *)&v, (const char *)&v + sizeof(v));
+        }
+        std::vector<char> blob;
+        for (const World *w : cur.maps)
+        {
+            serializeMapBinary(*w, blob);
+            std::uint64_t size = blob.size();
+            out.insert(out.end(), (const char *)&size, (const char *)&size + sizeof(size));
+            out.insert(out.end(), blob.begin(), blob.end());
+        }
+        const std::string config = formatExperiment(experiment());
+        std::uint64_t size = config.size();
+        out.insert(out.end(), (const char *)&size, (const char *)&size + sizeof(size));
+        out.insert(out.end(), config.begin(), config.end());
+    }
+
+    // Czy któryś lokalny proces roboczy już się zakończył (zakończone są zdejmowane z listy children)
+    bool childExited()
+    {
+        bool exited = false;
+        for (size_t k = 0; k < children.size();)
+        {
+            if (waitpid(children[k], nullptr, WNOHANG) == children[k])
+            {
+                children.erase(children.begin() + k);
+                exited = true;
+            }
+            else
+                ++k;
+        }
+        return exited;
+    }
+
+    // Kończy lokalne procesy robocze po nieudanym starcie (stop() tylko na nie czeka)
+    void killChildren()
+    {
+        for (pid_t pid : children)
+            kill(pid, SIGTERM);
+    }
+
+    // Dosyła robotnikowi partie, aż będzie miał PIPELINE_DEPTH w toku
+    void fillPipeline(Worker &w, const Population &pop, int generation)
+    {
+        while ((int)w.inFlight.size() < PIPELINE_DEPTH && !pending.empty() && w.fd >= 0)
+        {
+            Range r = pending.front();
+            BatchMessage b;
+            b.generation = generation;
+            b.first = r.first;
+            b.count = r.count;
+            b.reserved = 0;
+            if (!sendMessage(w.fd, MessageType::Batch, &b, sizeof(b), pop.genome(r.first), (size_t)r.count * pop.genomeSize * sizeof(Real)))
+            {
+                dropWorker(w);
+                return;
+            }
+            pending.pop_front();
+            w.inFlight.push_back(r);
+        }
+    }
+
+    // Wpisuje wynik partii (najstarszej w toku u robotnika w) do populacji i stanu lotów
+    bool storeResult(Population &pop, Worker &w)
+    {
+        ResultMessage r;
+        if (w.inFlight.empty() || payload.size() < sizeof(r))
+            return false;
+        std::memcpy(&r, payload.data(), sizeof(r));
+        const Range expected = w.inFlight.front();
+        const size_t flights = (size_t)r.count * r.scenarios;
+        if (r.first != expected.first || r.count != expected.count || r.scenarios != scenarios ||
+            payload.size() != sizeof(r) + r.count * sizeof(double) + flights * (sizeof(std::uint32_t) + sizeof(std::int32_t) + 1))
+            return false;
+        w.inFlight.pop_front();
+
+        const int n = pop.size;
+        const char *p = payload.data() + sizeof(r);
+        std::memcpy(pop.fitness.data() + r.first, p, r.count * sizeof(double));
+        p += r.count * sizeof(double);
+        const char *visited = p;
+        const char *timeAlive = visited + flights * sizeof(std::uint32_t);
+        const char *completed = timeAlive + flights * sizeof(std::int32_t);
+        for (int s = 0; s < r.scenarios; ++s)
+            for (int i = 0; i < r.count; ++i)
+            {
+                const size_t src = (size_t)s * r.count + i;
+                const int dst = s * n + r.first + i;
+                std::uint32_t v;
+                std::int32_t t;
+                std::memcpy(&v, visited + src * sizeof(v), sizeof(v));
+                std::memcpy(&t, timeAlive + src * sizeof(t), sizeof(t));
+                flightState.visitedCheckpoints[dst] = v;
+                flightState.timeAlive[dst] = t;
+                flightState.completed[dst] = (std::uint8_t)completed[src];
+            }
+        steps = std::max(steps, (int)r.steps);
+        return true;
+    }
+
+    // Robotnik się rozłączył albo przysłał błędne dane - jego partie wracają do kolejki.
+    // Tylko oznacza robotnika (fd = -1); z listy usuwa go removeDropped() poza pętlami po workers
+    void dropWorker(Worker &w)
+    {
+        if (w.fd < 0)
+            return;
+        std::cerr << "Robotnik rozłączony, jego partie przejmą pozostali" << std::endl;
+        ::close(w.fd);
+        w.fd = -1;
+        for (const Range &r : w.inFlight)
+            pending.push_front(r);
+        w.inFlight.clear();
+    }
+
+    void removeDropped()
+    {
+        workers.erase(std::remove_if(workers.begin(), workers.end(), [](const Worker &x)
+                                     { return x.fd < 0; }),
+                      workers.end());
+    }
+
+    std::string address;
+    int listenFd = -1;
+    int batchSize = DEFAULT_BATCH_SIZE;
+    int scenarios = 1;
+    int steps = 0;
+    std::vector<Worker> workers;
+    std::vector<pid_t> children;
+    std::deque<Range> pending;
+    std::vector<char> payload;
+    Population flightState;
+};
+
+#endif // DISTRIBUTED_H
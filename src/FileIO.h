@@ -0,0 +1,39 @@
+#ifndef FILE_IO_H
+#define FILE_IO_H
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Wczytuje cały plik do bufora jednym odczytem
+inline bool readFile(const std::string &path, std::vector<char> &out)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file)
+        return false;
+    out.resize((size_t)file.tellg());
+    file.seekg(0);
+    file.read(out.data(), out.size());
+    return bool(file);
+}
+
+// Zapisuje bufor do pliku tymczasowego i podmienia nim plik docelowy, więc przerwany zapis nie psuje poprzedniej wersji
+inline bool writeFileAtomic(const std::string &path, const std::vector<char> &data)
+{
+    const std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+        file.write(data.data(), data.size());
+        if (!file)
+            return false;
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+#endif // FILE_IO_H
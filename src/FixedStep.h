@@ -0,0 +1,88 @@
+#ifndef FIXED_STEP_H
+#define FIXED_STEP_H
+
+#include <chrono>
+#include <algorithm>
+
+// Stały krok czasu symulacji.
+// Symulacja zawsze wykonuje całe kroki o tej samej długości, a czas rzeczywisty jest tylko zbierany
+// w akumulatorze i zamieniany na liczbę kroków do wykonania w klatce. Dzięki temu wynik zależy jedynie
+// od ziarna i liczby kroków - nie od liczby klatek na sekundę ani od tego, czy cokolwiek jest rysowane.
+
+// kroki symulacji na sekundę przy prędkości 1x (tyle klatek na sekundę miała pierwotna pętla okna)
+const double SIM_TICK_RATE = 200.0;
+// najdłuższy czas klatki brany pod uwagę - po zacięciu okna symulacja nie próbuje nadrabiać bez końca
+const double MAX_FRAME_TIME = 0.25;
+// czas na kroki w jednej klatce przy prędkości maksymalnej (reszta klatki 60 Hz zostaje na rysowanie)
+const double MAX_SPEED_BUDGET = 0.012;
+
+enum class SimSpeed
+{
+    X1,
+    X10,
+    Max
+};
+
+inline const char *simSpeedName(SimSpeed speed)
+{
+    switch (speed)
+    {
+    case SimSpeed::X10:
+        return "10x";
+    case SimSpeed::Max:
+        return "max";
+    default:
+        return "1x";
+    }
+}
+
+class FixedStep
+{
+public:
+    void setSpeed(SimSpeed s)
+    {
+        speed = s;
+        accumulator = 0.0;
+    }
+    SimSpeed getSpeed() const { return speed; }
+
+    // Liczba kroków należnych po upływie frameSeconds (dla 1x i 10x)
+    int advance(double frameSeconds)
+    {
+        const double multiplier = speed == SimSpeed::X10 ? 10.0 : 1.0;
+        accumulator += std::min(frameSeconds, MAX_FRAME_TIME) * SIM_TICK_RATE * multiplier;
+        int steps = (int)accumulator;
+        accumulator -= steps;
+        return steps;
+    }
+
+    // Wykonuje kroki należne w tej klatce wywołując step(); przy prędkości maksymalnej
+    // kroki są wykonywane, dopóki nie minie MAX_SPEED_BUDGET. Zwraca liczbę wykonanych kroków
+    template <class StepFn>
+    int run(double frameSeconds, StepFn &&step)
+    {
+        if (speed != SimSpeed::Max)
+        {
+            int steps = advance(frameSeconds);
+            for (int s = 0; s < steps; ++s)
+                step();
+            return steps;
+        }
+
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        int steps = 0;
+        do
+        {
+            step();
+            steps++;
+        } while (std::chrono::duration<double>(clock::now() - start).count() < MAX_SPEED_BUDGET);
+        return steps;
+    }
+
+private:
+    SimSpeed speed = SimSpeed::X1;
+    double accumulator = 0.0;
+};
+
+#endif // FIXED_STEP_H
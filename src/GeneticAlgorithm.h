@@ -2,90 +2,103 @@
 #define GENETIC_ALGORITHM_H
 
 #include <vector>
+#include <cstdint>
 #include <algorithm>
-#include <cstdlib>
+#include <numeric>
 
-#include "Rocket.h"
-#include "Utils.h"
+#include "Population.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include "Config.h"
 
-// Konfiguracja
-const int POPULATION_SIZE = 100;      // ilość rakiet
-const int MUTATION_RATE = 5;          // 5%
-const double MUTATION_STRENGTH = 0.1; // 0-1
-const int LIFETIME = 2000;           // Czas trwania rundy
+// Konfiguracja (wielkość populacji, mutacja, elityzm, turniej, długość pokolenia) - ExperimentConfig w Config.h
+
+// liczba dzieci w jednej porcji pracy przy ewolucji wielowątkowej
+const int EVOLVE_GRAIN = 16;
+
+// Turniej (domyślnie 5 losowań) - zwraca numer najlepszego z losowo wybranych
+inline int tournament(const Population &pop, Rng &rng, int size)
+{
+    int best = pop.rank[rng.below(pop.size)];
+    for (int i = 0; i < size; ++i)
+    {
+        int cand = pop.rank[rng.below(pop.size)];
+        if (pop.fitness[cand] > pop.fitness[best])
+            best = cand;
+    }
+    return best;
+}
 
 // Ewolucja -
 // Implementuje Algorytm Genetyczny.
 // Sortuje rakiety od najlepszej do najgorszej.
 // Przepisuje najlepsze jednostki bez zmian do nowej populacji (Elityzm).
 // Tworzy resztę nowej populacji poprzez mieszanie wag dwóch rodziców (Crossover) i losowe zmiany wag (Mutacja).
-inline std::vector<Rocket> evolve(std::vector<Rocket> &oldPop, sf::Texture &t, sf::Texture &ft, sf::Vector2f startPos, int cpCount)
+// Dzieci zapisywane są wprost do drugiego bufora areny genotypów, który po ewolucji zamienia się z pierwszym,
+// więc krok nie alokuje pamięci. Każde dziecko ma własny strumień liczb losowych (ziarno, pokolenie, numer dziecka),
+// dzięki czemu dzieci można tworzyć równolegle, a wynik nie zależy od liczby wątków.
+inline void evolve(Population &pop, sf::Vector2f startPos, std::uint64_t seed, int generation, ThreadPool *pool = nullptr)
 {
-    // Inicjalizacja nowej populacji
-    std::vector<Rocket> newPop;
-    newPop.reserve(POPULATION_SIZE);
+    PROFILE_SCOPE(Phase::Evolve, pop.size);
 
-    // Sortowanie populacji
-    std::sort(oldPop.begin(), oldPop.end(), [](const Rocket &a, const Rocket &b)
-              { return a.fitness > b.fitness; });
+    // Ranking rakiet od najlepszej do najgorszej
+    std::iota(pop.rank.begin(), pop.rank.end(), 0);
+    std::sort(pop.rank.begin(), pop.rank.end(), [&](int a, int b)
+              { return pop.fitness[a] > pop.fitness[b]; });
 
-    // 1. ELITYZM - Zwiększony do 8, aby zachować stabilność
-    int eliteCount = 8;
-    for (int i = 0; i < std::min(eliteCount, (int)oldPop.size()); ++i)
-    {
-        // Klonowanie najlepszych rakiet
-        Rocket elita(t, ft, true);
-        elita.brain->setWeights(oldPop[i].brain->getWeights());
-        elita.reset(startPos, cpCount);
-        newPop.push_back(elita);
-    }
+    // 1. ELITYZM - domyślnie 8, aby zachować stabilność
+    const ExperimentConfig &cfg = experiment();
+    const int eliteCount = std::min(cfg.eliteCount, pop.size);
+    const int tournamentSize = cfg.tournamentSize;
+    const double mutationRate = cfg.mutationRate / 100.0;
+    const double mutationStrength = cfg.mutationStrength;
+    const int genomeSize = pop.genomeSize;
 
-    // 2. RESZTA POPULACJI (Crossover + Mutacja)
-    while (newPop.size() < POPULATION_SIZE)
+    auto makeChildren = [&](int begin, int end)
     {
-        // Selekcja Turniejowa
-        int best1 = rand() % oldPop.size();
-        for (int i = 0; i < 5; ++i)
-        { // Turniej 5 osobników
-            int cand = rand() % oldPop.size();
-            if (oldPop[cand].fitness > oldPop[best1].fitness)
-                best1 = cand;
-        }
-        int best2 = rand() % oldPop.size();
-        for (int i = 0; i < 5; ++i)
+        for (int child = begin; child < end; ++child)
         {
-            int cand = rand() % oldPop.size();
-            if (oldPop[cand].fitness > oldPop[best2].fitness)
-                best2 = cand;
-        }
+            Real *childGenes = pop.nextGenomes.data() + (size_t)child * genomeSize;
 
-        // Tworzenie nowej rakiety poprzez mieszanie wag dwóch rodziców
-        Rocket child(t, ft, true);
-        std::vector<double> genes1 = oldPop[best1].brain->getWeights();
-        std::vector<double> genes2 = oldPop[best2].brain->getWeights();
-        std::vector<double> childGenes;
+            // Klonowanie najlepszych rakiet
+            if (child < eliteCount)
+            {
+                const Real *genes = pop.genome(pop.rank[child]);
+                std::copy(genes, genes + genomeSize, childGenes);
+                continue;
+            }
 
-        // Mieszanie wag rodziców i mutacja
-        for (size_t i = 0; i < genes1.size(); ++i)
-        {
-            // Losowy wybór rodzica
-            double gene = (rand() % 2 == 0) ? genes1[i] : genes2[i];
-            // Mutacja
-            if ((rand() % 100) < MUTATION_RATE)
+            // 2. RESZTA POPULACJI (Crossover + Mutacja)
+            Rng rng = Rng::stream(seed, STREAM_EVOLVE, ((std::uint64_t)generation << 32) | (std::uint32_t)child);
+
+            // Selekcja Turniejowa
+            const Real *genes1 = pop.genome(tournament(pop, rng, tournamentSize));
+            const Real *genes2 = pop.genome(tournament(pop, rng, tournamentSize));
+
+            // Mieszanie wag rodziców - jeden 64-bitowy los wybiera rodzica dla 64 kolejnych genów
+            std::uint64_t bits = 0;
+            for (int i = 0; i < genomeSize; ++i)
             {
-                gene += randomRange(-MUTATION_STRENGTH, MUTATION_STRENGTH);
-                gene = std::max(-1.0, std::min(1.0, gene));
+                if ((i & 63) == 0)
+                    bits = rng.next();
+                childGenes[i] = (bits & 1) ? genes1[i] : genes2[i];
+                bits >>= 1;
             }
-            childGenes.push_back(gene);
+
+            // Mutacja
+            mutateSparse(rng, childGenes, genomeSize, mutationRate, mutationStrength);
         }
+    };
 
-        // Ustawienie wag nowej rakiety
-        child.brain->setWeights(childGenes);
-        child.reset(startPos, cpCount);
-        newPop.push_back(child);
-    }
+    if (pool)
+        pool->parallelFor(0, pop.size, EVOLVE_GRAIN, makeChildren);
+    else
+        makeChildren(0, pop.size);
 
-    return newPop;
+    // Nowa populacja staje się bieżącą
+    pop.genomes.swap(pop.nextGenomes);
+    pop.resetAll(startPos);
 }
 
 #endif // GENETIC_ALGORITHM_H
@@ -0,0 +1,307 @@
+#ifndef GENOME_FILE_H
+#define GENOME_FILE_H
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "siec/FlatNetwork.h"
+
+#include "Population.h"
+#include "FileIO.h"
+
+// Plik z jednym genotypem (.genome) - najlepsza rakieta pokolenia, do odtworzenia w replay.
+// Wagi można zapisać w pełnej precyzji albo skompresowane (bf16, int8) - do odtwarzania lotu
+// mniejsza precyzja zwykle wystarcza, a plik jest 4-8 razy mniejszy.
+// Little-endian:
+//     GenomeFileHeader
+//     int32   topology[layerCount]
+//     float   scales[layerCount - 1]     (tylko int8: skala wag każdej warstwy)
+//     weights[weightCount]               (f64 / f32 / bf16 / int8, kolejność NeuralNetwork::getWeights())
+
+const char GENOME_MAGIC[4] = {'R', 'G', 'E', 'N'};
+const std::uint32_t GENOME_VERSION = 2;
+
+// format zapisu wag
+enum class WeightFormat : std::int32_t
+{
+    F64 = 0,
+    F32 = 1,
+    BF16 = 2, // górne 16 bitów float (8 bitów wykładnika, 7 bitów mantysy)
+    I8 = 3    // liczby całkowite [-127, 127] ze skalą na warstwę
+};
+
+struct GenomeFileHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::int32_t generation;
+    std::int32_t layerCount;
+    std::int32_t weightCount;
+    std::int32_t laserCount;
+    double fitness;
+    std::int32_t weightFormat;
+    std::int32_t reserved;
+};
+static_assert(sizeof(GenomeFileHeader) == 40, "GenomeFileHeader musi mieć stały rozmiar");
+
+// Wczytany genotyp (wagi już zdekodowane)
+struct GenomeFile
+{
+    int generation = 0;
+    int laserCount = 0;
+    double fitness = 0.0;
+    WeightFormat format = WeightFormat::F64;
+    std::vector<int> topology;
+    std::vector<double> weights;
+};
+
+// Rozpoznaje format wag: "f64", "f32", "bf16" albo "i8"
+inline bool parseWeightFormat(const std::string &text, WeightFormat &format)
+{
+    if (text == "f64")
+        format = WeightFormat::F64;
+    else if (text == "f32")
+        format = WeightFormat::F32;
+    else if (text == "bf16")
+        format = WeightFormat::BF16;
+    else if (text == "i8")
+        format = WeightFormat::I8;
+    else
+        return false;
+    return true;
+}
+
+inline const char *weightFormatName(WeightFormat format)
+{
+    switch (format)
+    {
+    case WeightFormat::F32:
+        return "f32";
+    case WeightFormat::BF16:
+        return "bf16";
+    case WeightFormat::I8:
+        return "i8";
+    default:
+        return "f64";
+    }
+}
+
+inline size_t weightBytes(WeightFormat format)
+{
+    switch (format)
+    {
+    case WeightFormat::F32:
+        return 4;
+    case WeightFormat::BF16:
+        return 2;
+    case WeightFormat::I8:
+        return 1;
+    default:
+        return 8;
+    }
+}
+
+// float -> bfloat16 z zaokrągleniem do najbliższej (remis do parzystej)
+inline std::uint16_t floatToBf16(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    bits += 0x7FFFu + ((bits >> 16) & 1u);
+    return (std::uint16_t)(bits >> 16);
+}
+
+inline float bf16ToFloat(std::uint16_t value)
+{
+    std::uint32_t bits = (std::uint32_t)value << 16;
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+// Zapisuje genotyp rakiety i z populacji
+inline bool saveGenome(const std::string &path, const Population &pop, int i, int generation, WeightFormat format = WeightFormat::F64)
+{
+    GenomeFileHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, GENOME_MAGIC, 4);
+    h.version = GENOME_VERSION;
+    h.generation = generation;
+    h.layerCount = (std::int32_t)pop.topology.size();
+    h.weightCount = pop.genomeSize;
+    h.laserCount = pop.laserCount;
+    h.fitness = pop.fitness[i];
+    h.weightFormat = (std::int32_t)format;
+
+    const int layers = (int)pop.topology.size() - 1;
+    const size_t scaleBytes = format == WeightFormat::I8 ? layers * sizeof(float) : 0;
+    std::vector<char> data(sizeof(h) + pop.topology.size() * sizeof(std::int32_t) + scaleBytes + pop.genomeSize * weightBytes(format));
+    char *p = data.data();
+    std::memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    for (int layer : pop.topology)
+    {
+        std::int32_t v = layer;
+        std::memcpy(p, &v, sizeof(v));
+        p += sizeof(v);
+    }
+
+    const Real *genes = pop.genome(i);
+    if (format == WeightFormat::I8)
+    {
+        // skala warstwy: największa wartość bezwzględna trafia w 127
+        char *q = p + scaleBytes;
+        int offset = 0;
+        for (int l = 0; l < layers; ++l)
+        {
+            const int n = pop.topology[l] * pop.topology[l + 1];
+            double maxAbs = 0.0;
+            for (int k = 0; k < n; ++k)
+                maxAbs = std::max(maxAbs, (double)std::fabs(genes[offset + k]));
+            float scale = maxAbs > 0.0 ? (float)(maxAbs / 127.0) : 1.f;
+            std::memcpy(p, &scale, sizeof(scale));
+            p += sizeof(scale);
+            for (int k = 0; k < n; ++k)
+            {
+                long v = std::lround(genes[offset + k] / scale);
+                *q++ = (char)(std::int8_t)std::max(-127l, std::min(127l, v));
+            }
+            offset += n;
+        }
+        return writeFileAtomic(path, data);
+    }
+
+    for (int k = 0; k < pop.genomeSize; ++k)
+    {
+        if (format == WeightFormat::F64)
+        {
+            double v = genes[k];
+            std::memcpy(p, &v, sizeof(v));
+        }
+        else if (format == WeightFormat::F32)
+        {
+            float v = (float)genes[k];
+            std::memcpy(p, &v, sizeof(v));
+        }
+        else
+        {
+            std::uint16_t v = floatToBf16((float)genes[k]);
+            std::memcpy(p, &v, sizeof(v));
+        }
+        p += weightBytes(format);
+    }
+    return writeFileAtomic(path, data);
+}
+
+// Wczytuje genotyp z pliku i dekoduje wagi do double
+inline bool loadGenome(const std::string &path, GenomeFile &out)
+{
+    std::vector<char> data;
+    if (!readFile(path, data))
+    {
+        std::cerr << "Nie można otworzyć genotypu: " << path << std::endl;
+        return false;
+    }
+
+    GenomeFileHeader h;
+    if (data.size() < sizeof(h))
+    {
+        std::cerr << path << ": plik za krótki" << std::endl;
+        return false;
+    }
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (std::memcmp(h.magic, GENOME_MAGIC, 4) != 0 || h.version != GENOME_VERSION ||
+        h.weightFormat < (std::int32_t)WeightFormat::F64 || h.weightFormat > (std::int32_t)WeightFormat::I8)
+    {
+        std::cerr << path << ": nieznany format genotypu" << std::endl;
+        return false;
+    }
+    const WeightFormat format = (WeightFormat)h.weightFormat;
+    // liczniki z nagłówka ogranicza rozmiar pliku, zanim zostaną przemnożone (tak jak w parseMapBinary)
+    const size_t payload = data.size() - sizeof(h);
+    bool sizesOk = h.layerCount >= 2 && (size_t)h.layerCount <= payload / sizeof(std::int32_t) && h.weightCount > 0 &&
+                   (size_t)h.weightCount <= payload / weightBytes(format);
+    const size_t scaleBytes = sizesOk && format == WeightFormat::I8 ? (h.layerCount - 1) * sizeof(float) : 0;
+    if (sizesOk)
+    {
+        const std::uint64_t expected = sizeof(h) + (std::uint64_t)h.layerCount * sizeof(std::int32_t) + scaleBytes +
+                                       (std::uint64_t)h.weightCount * weightBytes(format);
+        sizesOk = data.size() == expected;
+    }
+    if (!sizesOk)
+    {
+        std::cerr << path << ": uszkodzony plik genotypu" << std::endl;
+        return false;
+    }
+
+    const char *p = data.data() + sizeof(h);
+    out.topology.resize(h.layerCount);
+    for (int l = 0; l < h.layerCount; ++l)
+    {
+        std::int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        out.topology[l] = v;
+    }
+    // rozmiary warstw > 0 i liczba wag bez przepełnienia int - dopiero potem weightCount()
+    if (!FlatNetwork::validTopology(out.topology, h.weightCount))
+    {
+        std::cerr << path << ": niepoprawna topologia sieci" << std::endl;
+        return false;
+    }
+    if (FlatNetwork::weightCount(out.topology) != h.weightCount)
+    {
+        std::cerr << path << ": liczba wag nie pasuje do topologii" << std::endl;
+        return false;
+    }
+
+    out.weights.resize(h.weightCount);
+    if (format == WeightFormat::I8)
+    {
+        const char *q = p + scaleBytes;
+        int offset = 0;
+        for (int l = 0; l + 1 < h.layerCount; ++l)
+        {
+            float scale;
+            std::memcpy(&scale, p, sizeof(scale));
+            p += sizeof(scale);
+            const int n = out.topology[l] * out.topology[l + 1];
+            for (int k = 0; k < n; ++k)
+                out.weights[offset + k] = (double)(std::int8_t)*q++ * scale;
+            offset += n;
+        }
+    }
+    else
+    {
+        for (int k = 0; k < h.weightCount; ++k)
+        {
+            if (format == WeightFormat::F64)
+                std::memcpy(&out.weights[k], p, sizeof(double));
+            else if (format == WeightFormat::F32)
+            {
+                float v;
+                std::memcpy(&v, p, sizeof(v));
+                out.weights[k] = v;
+            }
+            else
+            {
+                std::uint16_t v;
+                std::memcpy(&v, p, sizeof(v));
+                out.weights[k] = bf16ToFloat(v);
+            }
+            p += weightBytes(format);
+        }
+    }
+
+    out.generation = h.generation;
+    out.laserCount = h.laserCount;
+    out.fitness = h.fitness;
+    out.format = format;
+    return true;
+}
+
+#endif // GENOME_FILE_H
@@ -0,0 +1,19 @@
+#ifndef GEOMETRY_H
+#define GEOMETRY_H
+
+#include <algorithm>
+
+// Prostokąt wyrównany do osi (AABB) - zakres [min, max] w pikselach
+struct Box
+{
+    float minX, minY, maxX, maxY;
+};
+
+// czy prostokąty mają część wspólną o niezerowym polu (jak sf::FloatRect::findIntersection)
+inline bool boxesIntersect(const Box &a, const Box &b)
+{
+    return std::max(a.minX, b.minX) < std::min(a.maxX, b.maxX) &&
+           std::max(a.minY, b.minY) < std::min(a.maxY, b.maxY);
+}
+
+#endif // GEOMETRY_H
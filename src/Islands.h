@@ -0,0 +1,222 @@
+#ifndef ISLANDS_H
+#define ISLANDS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "World.h"
+#include "Population.h"
+#include "GeneticAlgorithm.h"
+#include "Simulation.h"
+#include "Curriculum.h"
+#include "Metrics.h"
+#include "Random.h"
+
+// Model wyspowy.
+// M podpopulacji (wysp) ewoluuje niezależnie, każda we własnym wątku, z własnym ziarnem i własnym cyklem
+// ocena -> evolve(). Co N pokoleń wyspa wysyła kopie swoich k najlepszych genotypów do następnej wyspy
+// w pierścieniu (i -> i + 1) i zastępuje swoje k najgorszych genotypami od poprzedniej.
+// Wyspy nie synchronizują się co pokolenie - czekają tylko na migrantów od sąsiada w pokoleniach migracji,
+// a migranci epoki e zawsze pochodzą z pokolenia e * N nadawcy, więc wynik nie zależy od tempa wątków.
+
+struct IslandSettings
+{
+    int islands = 1;       // liczba wysp (1 = zwykły algorytm na jednej populacji)
+    int migrateEvery = 10; // co ile pokoleń migracja
+    int migrants = 4;      // ilu najlepszych genotypów wysyła wyspa
+};
+
+// Skrzynka migrantów jednej wyspy: pisze tylko poprzednia wyspa, czyta tylko właścicielka.
+// Dwa bufory na zmianę (epoka e trafia do bufora e % 2), numery epok w zmiennych atomowych - bez blokad.
+// Nadawca czeka tylko wtedy, gdy odbiorca nie odebrał jeszcze epoki e - 2 (bufor nadal zajęty)
+class MigrationMailbox
+{
+public:
+    void init(int migrants, int genomeSize)
+    {
+        this->migrants = migrants;
+        this->genomeSize = genomeSize;
+        for (int b = 0; b < 2; ++b)
+        {
+            genomes[b].assign((size_t)migrants * genomeSize, Real(0));
+            fitness[b].assign(migrants, 0.0);
+        }
+    }
+
+    // Wysyła genotypy ids[0..migrants) populacji pop jako epokę epoch (1, 2, ...)
+    void send(int epoch, const Population &pop, const int *ids)
+    {
+        while (consumed.load(std::memory_order_acquire) < epoch - 2)
+            std::this_thread::yield();
+        const int b = epoch % 2;
+        for (int m = 0; m < migrants; ++m)
+        {
+            std::copy(pop.genome(ids[m]), pop.genome(ids[m]) + genomeSize, genomes[b].begin() + (size_t)m * genomeSize);
+            fitness[b][m] = pop.fitness[ids[m]];
+        }
+        published.store(epoch, std::memory_order_release);
+    }
+
+    // Wpisuje migrantów epoki epoch na miejsce genotypów ids[0..migrants) populacji pop (czeka na nadawcę)
+    void receive(int epoch, Population &pop, const int *ids)
+    {
+        while (published.load(std::memory_order_acquire) < epoch)
+            std::this_thread::yield();
+        const int b = epoch % 2;
+        for (int m = 0; m < migrants; ++m)
+        {
+            std::copy(genomes[b].begin() + (size_t)m * genomeSize, genomes[b].begin() + (size_t)(m + 1) * genomeSize, pop.genome(ids[m]));
+            pop.fitness[ids[m]] = fitness[b][m];
+        }
+        consumed.store(epoch, std::memory_order_release);
+    }
+
+private:
+    int migrants = 0;
+    int genomeSize = 0;
+    std::vector<Real> genomes[2];
+    std::vector<double> fitness[2];
+    std::atomic<int> published{0};
+    std::atomic<int> consumed{0};
+};
+
+// Ziarno wyspy - osobny strumień ziarna głównego dla każdej wyspy
+inline std::uint64_t islandSeed(std::uint64_t seed, int island)
+{
+    return Rng::stream(seed, STREAM_ISLAND, (std::uint64_t)island).next();
+}
+
+struct Island
+{
+    int index = 0;
+    std::uint64_t seed = 0;
+    Population pop;
+    Curriculum curriculum; // własna kopia ustawień oceny (epizody i scenariusze są stanem wyspy)
+    MigrationMailbox inbox;
+    std::vector<int> order; // bufor rankingu przy migracji
+
+    std::unique_ptr<MetricsWriter> metrics;
+    MetricsCollector collector;
+    GenerationMetrics generationMetrics;
+};
+
+class IslandModel
+{
+public:
+    // Tworzy wyspy po experiment().populationSize rakiet; ocena według ustawień (i torów) z settings
+    IslandModel(const IslandSettings &config, const Curriculum &settings, std::uint64_t seed)
+        : config(config), islands(std::max(1, config.islands))
+    {
+        this->config.islands = (int)islands.size();
+        this->config.migrants = std::max(0, std::min(config.migrants, experiment().populationSize / 2));
+        this->config.migrateEvery = std::max(1, config.migrateEvery);
+        for (int i = 0; i < (int)islands.size(); ++i)
+        {
+            Island &isl = islands[i];
+            isl.index = i;
+            isl.seed = islandSeed(seed, i);
+            isl.curriculum.maps = settings.maps;
+            isl.curriculum.startsPerMap = settings.startsPerMap;
+            isl.curriculum.startJitter = settings.startJitter;
+            isl.curriculum.aggregate = settings.aggregate;
+            isl.curriculum.percentile = settings.percentile;
+            isl.curriculum.earlyStop = settings.earlyStop;
+
+            // wagi początkowe z ziarna wyspy, żeby wyspy nie zaczynały od tych samych genotypów
+            isl.pop.resize(experiment().populationSize, experiment().laserCount(), experimentTopology());
+            for (int r = 0; r < isl.pop.size; ++r)
+            {
+                Rng rng = Rng::stream(isl.seed, STREAM_INIT_WEIGHTS, (std::uint64_t)r);
+                fillUniform(rng, isl.pop.genome(r), (size_t)isl.pop.genomeSize, -1.0, 1.0);
+            }
+            isl.pop.resetAll(settings.maps.front()->startPos);
+            isl.inbox.init(this->config.migrants, isl.pop.genomeSize);
+            isl.order.resize(isl.pop.size);
+        }
+    }
+
+    // Statystyki wysp wypisuje w tle osobny MetricsWriter każdej wyspy; metricsPath "run.csv" daje pliki "run-0.csv", "run-1.csv", ...
+    bool openMetrics(const std::string &metricsPath, int checkpointCount, bool showSteps)
+    {
+        for (Island &isl : islands)
+        {
+            isl.metrics = std::make_unique<MetricsWriter>(true, showSteps);
+            if (metricsPath.empty())
+                continue;
+            std::string path = metricsPath;
+            const std::string suffix = "-" + std::to_string(isl.index);
+            const size_t dot = path.find_last_of('.');
+            const size_t slash = path.find_last_of("/\\");
+            if (dot == std::string::npos || (slash != std::string::npos && slash > dot))
+                path += suffix;
+            else
+                path.insert(dot, suffix);
+            if (!isl.metrics->open(path, checkpointCount))
+                return false;
+        }
+        this->checkpointCount = checkpointCount;
+        return true;
+    }
+
+    // Uruchamia wyspy (każdą we własnym wątku) na maxGenerations pokoleń (0 = bez końca) i czeka na ich koniec
+    void run(int maxGenerations)
+    {
+        std::vector<std::thread> threads;
+        for (Island &isl : islands)
+            threads.emplace_back([this, &isl, maxGenerations]
+                                 { runIsland(isl, maxGenerations); });
+        for (std::thread &t : threads)
+            t.join();
+        for (Island &isl : islands)
+            if (isl.metrics)
+                isl.metrics->flush();
+    }
+
+    const std::vector<Island> &getIslands() const { return islands; }
+
+private:
+    void runIsland(Island &isl, int maxGenerations)
+    {
+        const sf::Vector2f startPos = isl.curriculum.maps.front()->startPos;
+        for (int generation = 1; maxGenerations <= 0 || generation <= maxGenerations; ++generation)
+        {
+            GenerationStats stats = runCurriculum(isl.curriculum, isl.pop, isl.seed, generation, nullptr);
+            if (isl.metrics)
+            {
+                isl.collector.collect(isl.generationMetrics, generation, stats, isl.pop, isl.curriculum.episodes, checkpointCount);
+                isl.generationMetrics.island = isl.index;
+                isl.metrics->push(isl.generationMetrics);
+            }
+
+            if (islands.size() > 1 && config.migrants > 0 && generation % config.migrateEvery == 0)
+                migrate(isl, generation / config.migrateEvery);
+
+            evolve(isl.pop, startPos, isl.seed, generation, nullptr);
+        }
+    }
+
+    // Migracja po ocenie pokolenia: najlepsi do następnej wyspy, migranci od poprzedniej na miejsce najgorszych
+    void migrate(Island &isl, int epoch)
+    {
+        Population &pop = isl.pop;
+        std::iota(isl.order.begin(), isl.order.end(), 0);
+        std::sort(isl.order.begin(), isl.order.end(), [&](int a, int b)
+                  { return pop.fitness[a] > pop.fitness[b]; });
+
+        Island &next = islands[(isl.index + 1) % islands.size()];
+        next.inbox.send(epoch, pop, isl.order.data());
+        isl.inbox.receive(epoch, pop, isl.order.data() + pop.size - config.migrants);
+    }
+
+    IslandSettings config;
+    std::vector<Island> islands;
+    int checkpointCount = 0;
+};
+
+#endif // ISLANDS_H
@@ -1,7 +1,7 @@
 #ifndef LASER_READING_H
 #define LASER_READING_H
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 
 // Struktura przechowująca wynik odczytu laseru
 struct LaserReading
@@ -0,0 +1,395 @@
+#ifndef MAP_LOADER_H
+#define MAP_LOADER_H
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "World.h"
+#include "FileIO.h"
+
+// Wczytywanie i zapis torów.
+//
+// Format tekstowy (.map) - jedna komenda na linię, '#' zaczyna komentarz:
+//     size <szerokość> <wysokość>
+//     start <x> <y>
+//     target <x> <y> [promień]            # środek celu końcowego
+//     obstacle <x> <y> <szerokość> <wysokość>
+//     checkpoint <x> <y> [promień]        # lewy górny róg, tak jak w createWorld()
+// Checkpointy zaliczane są w kolejności z pliku.
+//
+// Format binarny (.mapb) - stały układ little-endian, wszystkie pola 4-bajtowe, więc plik można
+// wczytać jednym odczytem (albo zmapować w pamięć) i skopiować tablice bez parsowania.
+// Zawiera gotową siatkę przeszkód, więc wczytanie nie przelicza indeksu przestrzennego:
+//     MapFileHeader
+//     Box     przeszkody[obstacleCount]
+//     Box     checkpointy[checkpointCount]
+//     int32   grid.start[gridCols * gridRows + 1]
+//     int32   grid.items[gridItemCount]
+
+const char MAP_MAGIC[4] = {'R', 'M', 'A', 'P'};
+const std::uint32_t MAP_VERSION = 1;
+
+struct MapFileHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    float width, height;
+    float startX, startY;
+    float celX, celY, celRadius;
+    std::uint32_t obstacleCount;
+    std::uint32_t checkpointCount;
+    float gridOriginX, gridOriginY, gridCellSize;
+    std::uint32_t gridCols, gridRows;
+    std::uint32_t gridItemCount;
+};
+static_assert(sizeof(MapFileHeader) == 68, "MapFileHeader musi mieć stały rozmiar");
+static_assert(sizeof(Box) == 16, "Box musi mieć stały rozmiar");
+
+inline bool isFiniteBox(const Box &b)
+{
+    return std::isfinite(b.minX) && std::isfinite(b.minY) && std::isfinite(b.maxX) && std::isfinite(b.maxY);
+}
+
+// sprawdza dane wspólne dla obu formatów
+inline bool validateWorld(const World &world, const std::string &path)
+{
+    if (world.checkpointCount() > 32)
+    {
+        std::cerr << path << ": za dużo checkpointów (maks. 32)" << std::endl;
+        return false;
+    }
+    const float values[] = {world.width, world.height, world.startPos.x, world.startPos.y, world.cel.x, world.cel.y, world.celRadius};
+    for (float v : values)
+    {
+        if (!std::isfinite(v))
+        {
+            std::cerr << path << ": niepoprawna liczba (NaN lub nieskończoność)" << std::endl;
+            return false;
+        }
+    }
+    if (!(world.celRadius > 0.f))
+    {
+        std::cerr << path << ": promień celu musi być > 0" << std::endl;
+        return false;
+    }
+    for (const Box &b : world.przeszkody)
+    {
+        if (!isFiniteBox(b) || !(b.maxX > b.minX && b.maxY > b.minY))
+        {
+            std::cerr << path << ": przeszkoda o zerowym rozmiarze lub niepoprawnych współrzędnych" << std::endl;
+            return false;
+        }
+    }
+    for (const Box &b : world.checkpoints)
+    {
+        if (!isFiniteBox(b) || !(b.maxX > b.minX && b.maxY > b.minY))
+        {
+            std::cerr << path << ": checkpoint o niedodatnim promieniu lub niepoprawnych współrzędnych" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Czyta opcjonalną liczbę na końcu linii; false, gdy jej nie ma (in.eof()) albo nie jest liczbą (!in.eof())
+inline bool readOptional(std::istringstream &in, float &value)
+{
+    in >> std::ws;
+    if (in.eof())
+        return false;
+    return bool(in >> value);
+}
+
+// Wczytuje tor w formacie tekstowym
+inline bool loadMapText(const std::string &path, World &out)
+{
+    std::ifstream file(path);
+    if (!file)
+    {
+        std::cerr << "Nie można otworzyć toru: " << path << std::endl;
+        return false;
+    }
+
+    World world;
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(file, line))
+    {
+        lineNo++;
+        line = line.substr(0, line.find('#'));
+        std::istringstream in(line);
+        std::string cmd;
+        if (!(in >> cmd))
+            continue;
+
+        bool ok = true;
+        if (cmd == "size")
+            ok = bool(in >> world.width >> world.height);
+        else if (cmd == "start")
+            ok = bool(in >> world.startPos.x >> world.startPos.y);
+        else if (cmd == "target")
+        {
+            ok = bool(in >> world.cel.x >> world.cel.y);
+            float r;
+            if (ok && readOptional(in, r))
+                world.celRadius = r;
+            else if (ok)
+                ok = in.eof();
+        }
+        else if (cmd == "obstacle")
+        {
+            float x, y, w, h;
+            ok = bool(in >> x >> y >> w >> h);
+            if (ok)
+                world.dodajPrzeszkode({w, h}, {x, y});
+        }
+        else if (cmd == "checkpoint")
+        {
+            float x, y, r = 70.f;
+            ok = bool(in >> x >> y);
+            if (ok && !readOptional(in, r))
+                ok = in.eof();
+            if (ok)
+                world.dodajCheckpoint({x, y}, r);
+        }
+        else
+            ok = false;
+
+        // nadmiarowe wartości na końcu linii (np. "obstacle 1 2 3 4 5") to błąd, a nie komentarz
+        std::string rest;
+        ok = ok && !(in >> rest);
+
+        if (!ok)
+        {
+            std::cerr << path << ":" << lineNo << ": niepoprawna linia: " << line << std::endl;
+            return false;
+        }
+    }
+
+    if (!validateWorld(world, path))
+        return false;
+    world.finalize();
+    out = std::move(world);
+    return true;
+}
+
+// Rozmiar w, dla którego min + w daje dokładnie max - format tekstowy zapisuje przeszkody i checkpointy jako
+// pozycję i rozmiar, a loadMapText liczy z nich koniec prostokąta (max - min po zaokrągleniu nie zawsze wystarcza)
+inline float exactExtent(float min, float max)
+{
+    float w = max - min;
+    for (int k = 0; k < 8 && min + w != max; ++k)
+        w = std::nextafter(w, min + w < max ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity());
+    return w;
+}
+
+// Promień r checkpointu, dla którego dodajCheckpoint() odtwarza ten sam Box (min + 2r == max w obu osiach);
+// gdy takiego nie ma w pobliżu, zgodna zostaje przynajmniej oś X
+inline float exactRadius(const Box &b)
+{
+    const float base = exactExtent(b.minX, b.maxX) / 2.f;
+    float down = base, up = base;
+    for (int k = 0; k < 8; ++k)
+    {
+        for (float r : {down, up})
+            if (b.minX + 2.f * r == b.maxX && b.minY + 2.f * r == b.maxY)
+                return r;
+        down = std::nextafter(down, 0.f);
+        up = std::nextafter(up, std::numeric_limits<float>::infinity());
+    }
+    return base;
+}
+
+// Zapisuje tor w formacie tekstowym
+inline bool saveMapText(const std::string &path, const World &world)
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+    // pełna precyzja float - .mapb -> .map -> .mapb nie gubi współrzędnych niecałkowitych
+    file << std::setprecision(std::numeric_limits<float>::max_digits10);
+    file << "size " << world.width << " " << world.height << "\n";
+    file << "start " << world.startPos.x << " " << world.startPos.y << "\n";
+    file << "target " << world.cel.x << " " << world.cel.y << " " << world.celRadius << "\n";
+    for (const Box &b : world.przeszkody)
+        file << "obstacle " << b.minX << " " << b.minY << " " << exactExtent(b.minX, b.maxX) << " " << exactExtent(b.minY, b.maxY) << "\n";
+    for (const Box &b : world.checkpoints)
+        file << "checkpoint " << b.minX << " " << b.minY << " " << exactRadius(b) << "\n";
+    return bool(file);
+}
+
+// Serializuje tor do bufora w formacie binarnym (z gotową siatką przeszkód)
+inline void serializeMapBinary(const World &world, std::vector<char> &out)
+{
+    MapFileHeader h;
+    std::memcpy(h.magic, MAP_MAGIC, 4);
+    h.version = MAP_VERSION;
+    h.width = world.width;
+    h.height = world.height;
+    h.startX = world.startPos.x;
+    h.startY = world.startPos.y;
+    h.celX = world.cel.x;
+    h.celY = world.cel.y;
+    h.celRadius = world.celRadius;
+    h.obstacleCount = (std::uint32_t)world.przeszkody.size();
+    h.checkpointCount = (std::uint32_t)world.checkpoints.size();
+    h.gridOriginX = world.grid.originX;
+    h.gridOriginY = world.grid.originY;
+    h.gridCellSize = world.grid.cellSize;
+    h.gridCols = (std::uint32_t)world.grid.cols;
+    h.gridRows = (std::uint32_t)world.grid.rows;
+    h.gridItemCount = (std::uint32_t)world.grid.items.size();
+
+    const size_t obstacleBytes = world.przeszkody.size() * sizeof(Box);
+    const size_t checkpointBytes = world.checkpoints.size() * sizeof(Box);
+    const size_t startBytes = world.grid.start.size() * sizeof(int);
+    const size_t itemBytes = world.grid.items.size() * sizeof(int);
+    out.resize(sizeof(h) + obstacleBytes + checkpointBytes + startBytes + itemBytes);
+    char *p = out.data();
+    std::memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    std::memcpy(p, world.przeszkody.data(), obstacleBytes);
+    p += obstacleBytes;
+    std::memcpy(p, world.checkpoints.data(), checkpointBytes);
+    p += checkpointBytes;
+    std::memcpy(p, world.grid.start.data(), startBytes);
+    p += startBytes;
+    std::memcpy(p, world.grid.items.data(), itemBytes);
+}
+
+// Zapisuje tor w formacie binarnym (z gotową siatką przeszkód)
+inline bool saveMapBinary(const std::string &path, const World &world)
+{
+    std::vector<char> data;
+    serializeMapBinary(world, data);
+    return writeFileAtomic(path, data);
+}
+
+// Sprawdza spójność siatki wczytanej z pliku: start[0] == 0, start niemalejące, start.back() == items.size()
+// i każdy indeks w items wskazuje istniejącą przeszkodę (forEachCandidate() nie sprawdza zakresów)
+inline bool validateGrid(const ObstacleGrid &grid, size_t obstacleCount)
+{
+    if (grid.empty())
+        return grid.start.empty() && grid.items.empty();
+    if (!(grid.cellSize > 0.f) || !std::isfinite(grid.cellSize))
+        return false;
+    if (grid.start.front() != 0 || (size_t)grid.start.back() != grid.items.size())
+        return false;
+    for (size_t c = 1; c < grid.start.size(); ++c)
+        if (grid.start[c] < grid.start[c - 1])
+            return false;
+    for (int k : grid.items)
+        if (k < 0 || (size_t)k >= obstacleCount)
+            return false;
+    return true;
+}
+
+// Odczytuje tor z bufora w formacie binarnym; name - nazwa źródła do komunikatów o błędach
+inline bool parseMapBinary(const std::vector<char> &data, const std::string &name, World &out)
+{
+    MapFileHeader h;
+    if (data.size() < sizeof(h))
+    {
+        std::cerr << name << ": plik za krótki" << std::endl;
+        return false;
+    }
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (std::memcmp(h.magic, MAP_MAGIC, 4) != 0 || h.version != MAP_VERSION)
+    {
+        std::cerr << name << ": nieznany format toru" << std::endl;
+        return false;
+    }
+
+    // liczniki z nagłówka ogranicza rozmiar pliku, zanim zostaną przemnożone (brak przepełnienia size_t)
+    const size_t payload = data.size() - sizeof(h);
+    const size_t maxInts = payload / sizeof(int);
+    bool sizesOk = h.obstacleCount <= payload / sizeof(Box) && h.checkpointCount <= payload / sizeof(Box) &&
+                   h.gridItemCount <= maxInts && h.gridCols <= (std::uint32_t)INT_MAX &&
+                   h.gridRows <= (std::uint32_t)INT_MAX && (h.gridCols == 0) == (h.gridRows == 0) &&
+                   (h.gridCols == 0 || h.gridRows <= maxInts / h.gridCols);
+    size_t gridCells = h.gridCols > 0 ? (size_t)h.gridCols * h.gridRows + 1 : 0;
+    if (sizesOk)
+    {
+        size_t expected = sizeof(h) + (h.obstacleCount + (size_t)h.checkpointCount) * sizeof(Box) +
+                          (gridCells + h.gridItemCount) * sizeof(int);
+        sizesOk = data.size() == expected;
+    }
+    if (!sizesOk)
+    {
+        std::cerr << name << ": uszkodzony plik toru" << std::endl;
+        return false;
+    }
+
+    World world;
+    world.width = h.width;
+    world.height = h.height;
+    world.startPos = {h.startX, h.startY};
+    world.cel = {h.celX, h.celY};
+    world.celRadius = h.celRadius;
+
+    const char *p = data.data() + sizeof(h);
+    world.przeszkody.resize(h.obstacleCount);
+    std::memcpy(world.przeszkody.data(), p, h.obstacleCount * sizeof(Box));
+    p += h.obstacleCount * sizeof(Box);
+    world.checkpoints.resize(h.checkpointCount);
+    std::memcpy(world.checkpoints.data(), p, h.checkpointCount * sizeof(Box));
+    p += h.checkpointCount * sizeof(Box);
+
+    for (const Box &b : world.przeszkody)
+        world.przeszkodySoA.add(b);
+
+    world.grid.originX = h.gridOriginX;
+    world.grid.originY = h.gridOriginY;
+    world.grid.cellSize = h.gridCellSize;
+    world.grid.cols = (int)h.gridCols;
+    world.grid.rows = (int)h.gridRows;
+    world.grid.start.resize(gridCells);
+    std::memcpy(world.grid.start.data(), p, gridCells * sizeof(int));
+    p += gridCells * sizeof(int);
+    world.grid.items.resize(h.gridItemCount);
+    std::memcpy(world.grid.items.data(), p, h.gridItemCount * sizeof(int));
+
+    if (!validateGrid(world.grid, h.obstacleCount))
+    {
+        std::cerr << name << ": uszkodzona siatka przeszkód" << std::endl;
+        return false;
+    }
+    if (!validateWorld(world, name))
+        return false;
+    out = std::move(world);
+    return true;
+}
+
+// Wczytuje tor z formatu binarnego - jeden odczyt pliku i kopiowanie tablic
+inline bool loadMapBinary(const std::string &path, World &out)
+{
+    std::vector<char> data;
+    if (!readFile(path, data))
+    {
+        std::cerr << "Nie można otworzyć toru: " << path << std::endl;
+        return false;
+    }
+    return parseMapBinary(data, path, out);
+}
+
+// Wczytuje tor, rozpoznając format po nagłówku pliku
+inline bool loadMap(const std::string &path, World &out)
+{
+    std::ifstream file(path, std::ios::binary);
+    char magic[4] = {};
+    file.read(magic, 4);
+    if (file && std::memcmp(magic, MAP_MAGIC, 4) == 0)
+        return loadMapBinary(path, out);
+    return loadMapText(path, out);
+}
+
+#endif // MAP_LOADER_H
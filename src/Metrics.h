@@ -0,0 +1,278 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Population.h"
+#include "GeneticAlgorithm.h"
+
+// Statystyki pokoleń.
+// Symulacja tylko wypełnia GenerationMetrics i wkłada je do pierścienia (bez alokacji i bez wejścia-wyjścia),
+// a osobny wątek formatuje je i wypisuje na konsolę i/lub do pliku CSV. Przy pokoleniach trwających
+// milisekundy synchroniczne std::endl na konsolę byłyby zauważalną częścią czasu treningu.
+
+// Statystyki zakończonego pokolenia
+struct GenerationStats
+{
+    double maxFit = -std::numeric_limits<double>::infinity();
+    double sumFit = 0.0;
+    int completedCount = 0;
+    int maxCheckpoints = 0;
+    int steps = 0; // liczba kroków pokolenia (mniej niż lifetime przy wcześniejszym końcu)
+};
+
+// Tekst statystyk pokolenia na konsolę; showSteps dodaje liczbę wykonanych kroków, island >= 0 numer wyspy (Islands.h)
+inline std::string formatGenerationStats(int generation, const GenerationStats &stats, int populationSize, int checkpointCount, bool showSteps = false,
+                                         int island = -1)
+{
+    std::ostringstream out;
+    out << "=== GEN " << generation;
+    if (island >= 0)
+        out << " | wyspa " << island;
+    out << " ===\n";
+    out << "  Max Fitness: " << (long)stats.maxFit << "\n";
+    out << "  Ukończone: " << stats.completedCount << "/" << populationSize << "\n";
+    out << "  Max CP: " << stats.maxCheckpoints << "/" << checkpointCount << "\n";
+    if (showSteps)
+        out << "  Kroki: " << stats.steps << "/" << experiment().lifetime + 1 << "\n";
+    return out.str();
+}
+
+// Pełne statystyki pokolenia do analizy (stały rozmiar - bez alokacji w pierścieniu)
+struct GenerationMetrics
+{
+    int generation = 0;
+    int island = -1; // numer wyspy w modelu wyspowym (-1 = jedna populacja)
+    GenerationStats stats;
+    int population = 0;      // liczba genotypów
+    int episodes = 0;        // liczba lotów (genotypy x scenariusze)
+    int checkpointCount = 0; // checkpointy toru (największa liczba przy kilku torach)
+    double meanFitness = 0.0;
+    double medianFitness = 0.0;
+    double meanTimeToGoal = 0.0; // średnia liczba kroków ukończonych lotów (0, gdy żaden nie ukończył)
+    double diversity = 0.0;      // średnie odchylenie standardowe wag w populacji
+    std::array<int, 33> checkpointHistogram{}; // liczba lotów z k zdobytymi checkpointami
+};
+
+// Liczy GenerationMetrics; bufory pomocnicze są używane ponownie między pokoleniami
+class MetricsCollector
+{
+public:
+    // pop - genotypy i ich (zagregowany) fitness, flights - stan lotów po pokoleniu (ta sama populacja
+    // albo epizody wszystkich scenariuszy w Curriculum)
+    void collect(GenerationMetrics &m, int generation, const GenerationStats &stats, const Population &pop, const Population &flights, int checkpointCount)
+    {
+        m.generation = generation;
+        m.stats = stats;
+        m.population = pop.size;
+        m.episodes = flights.size;
+        m.checkpointCount = checkpointCount;
+        m.meanFitness = pop.size ? stats.sumFit / pop.size : 0.0;
+
+        sorted.assign(pop.fitness.begin(), pop.fitness.end());
+        if (!sorted.empty())
+        {
+            auto mid = sorted.begin() + sorted.size() / 2;
+            std::nth_element(sorted.begin(), mid, sorted.end());
+            m.medianFitness = *mid;
+            if (sorted.size() % 2 == 0)
+                m.medianFitness = (m.medianFitness + *std::max_element(sorted.begin(), mid)) / 2.0;
+        }
+
+        m.checkpointHistogram.fill(0);
+        long long goalSteps = 0;
+        int completed = 0;
+        for (int i = 0; i < flights.size; ++i)
+        {
+            m.checkpointHistogram[std::min(flights.checkpointsVisited(i), (int)m.checkpointHistogram.size() - 1)]++;
+            if (flights.completed[i])
+            {
+                goalSteps += flights.timeAlive[i];
+                completed++;
+            }
+        }
+        m.meanTimeToGoal = completed ? (double)goalSteps / completed : 0.0;
+
+        // odchylenie standardowe każdej wagi w populacji, wiersz po wierszu (pamięć przechodzona liniowo)
+        const int g = pop.genomeSize;
+        sum.assign(g, 0.0);
+        sumSq.assign(g, 0.0);
+        for (int i = 0; i < pop.size; ++i)
+        {
+            const Real *genes = pop.genome(i);
+            for (int k = 0; k < g; ++k)
+            {
+                sum[k] += genes[k];
+                sumSq[k] += (double)genes[k] * genes[k];
+            }
+        }
+        double total = 0.0;
+        for (int k = 0; k < g && pop.size > 0; ++k)
+        {
+            double mean = sum[k] / pop.size;
+            total += std::sqrt(std::max(0.0, sumSq[k] / pop.size - mean * mean));
+        }
+        m.diversity = g ? total / g : 0.0;
+    }
+
+private:
+    std::vector<double> sorted;
+    std::vector<double> sum, sumSq;
+};
+
+// pojemność pierścienia - tyle pokoleń może czekać na zapis, zanim symulacja zacznie czekać na wątek zapisu
+const int METRICS_RING_SIZE = 256;
+// jak często wątek zapisu zbiera czekające pokolenia
+const std::chrono::milliseconds METRICS_FLUSH_INTERVAL{200};
+
+// Zapis statystyk w tle. push() kopiuje GenerationMetrics do pierścienia jednego producenta i jednego
+// konsumenta (bez blokad); wątek zapisu co najwyżej co METRICS_FLUSH_INTERVAL zbiera wszystkie czekające
+// pokolenia, formatuje je i wypisuje jednym zapisem na konsolę (echo) i do pliku CSV
+class MetricsWriter
+{
+public:
+    // echo - wypisywać statystyki na konsolę, showSteps - z liczbą kroków pokolenia
+    explicit MetricsWriter(bool echo = true, bool showSteps = false)
+        : echo(echo), showSteps(showSteps), worker([this]
+                                                    { writerLoop(); }) {}
+
+    ~MetricsWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    MetricsWriter(const MetricsWriter &) = delete;
+    MetricsWriter &operator=(const MetricsWriter &) = delete;
+
+    // Otwiera plik CSV (przed pierwszym push); checkpointCount - liczba kolumn histogramu
+    bool open(const std::string &path, int checkpointCount)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        file.open(path, std::ios::out | std::ios::trunc);
+        if (!file)
+        {
+            std::cerr << "Nie można otworzyć pliku statystyk: " << path << std::endl;
+            return false;
+        }
+        histogramColumns = std::min(checkpointCount + 1, 33);
+        file << "generation,max_fitness,mean_fitness,median_fitness,completed,population,episodes,mean_time_to_goal,diversity,steps,max_cp";
+        for (int k = 0; k < histogramColumns; ++k)
+            file << ",cp_" << k;
+        file << '\n';
+        return true;
+    }
+
+    // Dodaje pokolenie do zapisu (tylko z jednego wątku)
+    void push(const GenerationMetrics &m)
+    {
+        const std::uint64_t h = head.load(std::memory_order_relaxed);
+        // pełny pierścień - czekamy, aż wątek zapisu zwolni miejsce
+        while (h - tail.load(std::memory_order_acquire) >= METRICS_RING_SIZE)
+        {
+            cv.notify_all();
+            std::this_thread::yield();
+        }
+        ring[h % METRICS_RING_SIZE] = m;
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Czeka na wypisanie wszystkich dodanych pokoleń
+    void flush()
+    {
+        const std::uint64_t target = head.load(std::memory_order_relaxed);
+        std::unique_lock<std::mutex> lock(mutex);
+        flushRequested = true;
+        cv.notify_all();
+        cv.wait(lock, [&]
+                { return written >= target; });
+    }
+
+private:
+    void writerLoop()
+    {
+        std::string consoleText, fileText;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait_for(lock, METRICS_FLUSH_INTERVAL, [this]
+                        { return stopping || flushRequested || written + METRICS_RING_SIZE / 2 <= head.load(std::memory_order_acquire); });
+            const std::uint64_t h = head.load(std::memory_order_acquire);
+            const bool stop = stopping;
+            flushRequested = false;
+            if (written == h)
+            {
+                if (stop)
+                    return;
+                continue;
+            }
+            lock.unlock();
+
+            consoleText.clear();
+            fileText.clear();
+            for (std::uint64_t t = written; t < h; ++t)
+                format(ring[t % METRICS_RING_SIZE], consoleText, fileText);
+            tail.store(h, std::memory_order_release);
+            if (echo)
+                std::cout << consoleText << std::flush;
+            if (file.is_open())
+                file << fileText << std::flush;
+
+            lock.lock();
+            written = h;
+            cv.notify_all();
+        }
+    }
+
+    void format(const GenerationMetrics &m, std::string &consoleText, std::string &fileText)
+    {
+        if (echo)
+            consoleText += formatGenerationStats(m.generation, m.stats, m.population, m.checkpointCount, showSteps, m.island);
+        if (!file.is_open())
+            return;
+        std::ostringstream out;
+        out << m.generation << ',' << m.stats.maxFit << ',' << m.meanFitness << ',' << m.medianFitness << ','
+            << m.stats.completedCount << ',' << m.population << ',' << m.episodes << ',' << m.meanTimeToGoal << ','
+            << m.diversity << ',' << m.stats.steps << ',' << m.stats.maxCheckpoints;
+        for (int k = 0; k < histogramColumns; ++k)
+            out << ',' << m.checkpointHistogram[k];
+        out << '\n';
+        fileText += out.str();
+    }
+
+    std::array<GenerationMetrics, METRICS_RING_SIZE> ring;
+    std::atomic<std::uint64_t> head{0}; // następne wolne miejsce (pisze producent)
+    std::atomic<std::uint64_t> tail{0}; // pierwsze miejsce jeszcze nie skopiowane przez wątek zapisu
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::uint64_t written = 0; // pokolenia już wypisane
+    bool flushRequested = false;
+    bool stopping = false;
+
+    std::ofstream file;
+    int histogramColumns = 0;
+    bool echo;
+    bool showSteps;
+    std::thread worker; // ostatnie pole - startuje po zainicjalizowaniu pozostałych
+};
+
+#endif // METRICS_H
@@ -0,0 +1,184 @@
+#ifndef POPULATION_H
+#define POPULATION_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+#include <bitset>
+#include <cstdint>
+#include <algorithm>
+
+#include "siec/FlatNetwork.h"
+#include "siec/BatchedNetwork.h"
+#include "siec/Precision.h"
+
+#include "Random.h"
+
+// liczba rakiet w jednej porcji pracy przy kroku symulacji
+const int STEP_GRAIN = 64;
+
+// Populacja rakiet w układzie struktury tablic (SoA).
+// Każde pole to osobna ciągła tablica indeksowana numerem rakiety, więc kroki fizyki,
+// czujników i fitnessu przechodzą po pamięci liniowo. Sprite'y powstają dopiero przy rysowaniu.
+struct Population
+{
+    int size = 0;
+    int laserCount = 0;
+
+    // kinematyka
+    std::vector<float> posX, posY;
+    std::vector<float> velX, velY;
+    std::vector<float> rotation; // w stopniach, zakres [0, 360)
+
+    // stan
+    std::vector<std::uint8_t> dead;
+    std::vector<std::uint8_t> completed;
+    std::vector<std::uint8_t> thrusting;
+    std::vector<double> fitness;
+
+    // statystyki
+    std::vector<int> timeAlive;
+    std::vector<std::uint32_t> visitedCheckpoints; // maska bitowa, maks. 32 checkpointy
+    std::vector<float> bestDistanceToTarget;       // resetowane przy każdym checkpoincie
+    std::vector<float> lastPosX, lastPosY;
+    std::vector<int> stuckCounter;
+
+    // odczyty laserów [size * laserCount], wiersz na rakietę
+    std::vector<float> laserDist;
+    std::vector<std::uint8_t> laserHit;
+
+    // arena genotypów [size * genomeSize] - wagi sieci kolejnych rakiet leżą jedna za drugą,
+    // w kolejności NeuralNetwork::getWeights(); typ Real (double albo float, zob. Precision.h)
+    std::vector<int> topology;
+    int genomeSize = 0;
+    std::vector<Real> genomes;
+    // drugi bufor areny - ewolucja zapisuje do niego dzieci, po czym bufory są zamieniane
+    std::vector<Real> nextGenomes;
+    // ranking rakiet wg fitnessu (bufor dla ewolucji)
+    std::vector<int> rank;
+
+    // wsadowe przejście w przód dla żywych rakiet (wiersz partii r liczy sieć rakiety activeIds[r])
+    BatchedNetwork net;
+
+    // zbiór aktywnych rakiet, zwarty w obrębie porcji kroku: porcja c obejmuje pozycje
+    // [chunkBegin[c], chunkBegin[c + 1]), a jej aktywne rakiety to pierwsze chunkActive[c] wpisów activeIds
+    // od chunkBegin[c]. Martwe i ukończone rakiety są usuwane przez zamianę z ostatnią aktywną,
+    // więc krok nie przegląda już rakiet, które skończyły lot
+    std::vector<int> activeIds;
+    std::vector<int> chunkBegin;
+    std::vector<int> chunkActive;
+
+    // alokuje tablice dla n rakiet i losuje im wagi sieci o zadanej topologii
+    void resize(int n, int lasers, const std::vector<int> &netTopology)
+    {
+        size = n;
+        laserCount = lasers;
+        topology = netTopology;
+
+        posX.assign(n, 0.f);
+        posY.assign(n, 0.f);
+        velX.assign(n, 0.f);
+        velY.assign(n, 0.f);
+        rotation.assign(n, 0.f);
+
+        dead.assign(n, 0);
+        completed.assign(n, 0);
+        thrusting.assign(n, 0);
+        fitness.assign(n, 0.0);
+
+        timeAlive.assign(n, 0);
+        visitedCheckpoints.assign(n, 0);
+        bestDistanceToTarget.assign(n, 999999.f);
+        lastPosX.assign(n, 0.f);
+        lastPosY.assign(n, 0.f);
+        stuckCounter.assign(n, 0);
+
+        laserDist.assign((size_t)n * lasers, 0.f);
+        laserHit.assign((size_t)n * lasers, 0);
+
+        genomeSize = FlatNetwork::weightCount(topology);
+        genomes.resize((size_t)n * genomeSize);
+        // każda rakieta ma własny strumień, więc wagi zależą tylko od ziarna głównego
+        for (int i = 0; i < n; ++i)
+        {
+            Rng rng = Rng::stream(masterSeed(), STREAM_INIT_WEIGHTS, (std::uint64_t)i);
+            fillUniform(rng, genome(i), (size_t)genomeSize, -1.0, 1.0);
+        }
+        nextGenomes.assign(genomes.size(), Real(0));
+        rank.assign(n, 0);
+
+        net = BatchedNetwork(topology, n);
+        activeIds.assign(n, 0);
+        activateAll();
+    }
+
+    // resetuje rakietę do nowej rundy (pokolenia). Resetuje pozycję, prędkość i flagi życia, ale zachowuje wytrenowany "mózg"
+    void reset(int i, sf::Vector2f startPosition)
+    {
+        dead[i] = 0;
+        completed[i] = 0;
+        thrusting[i] = 0;
+        posX[i] = startPosition.x;
+        posY[i] = startPosition.y;
+        rotation[i] = 0.f;
+        velX[i] = 0.f;
+        velY[i] = 0.f;
+        fitness[i] = 0.0;
+        timeAlive[i] = 0;
+        bestDistanceToTarget[i] = 999999.f;
+        stuckCounter[i] = 0;
+        lastPosX[i] = startPosition.x;
+        lastPosY[i] = startPosition.y;
+        visitedCheckpoints[i] = 0;
+    }
+
+    void resetAll(sf::Vector2f startPosition)
+    {
+        for (int i = 0; i < size; ++i)
+            reset(i, startPosition);
+        activateAll();
+    }
+
+    // Buduje zbiór aktywnych rakiet od nowa: porcje po STEP_GRAIN rakiet w obrębie segmentów po segment rakiet
+    // (0 = cała populacja; porcja nie przekracza granicy segmentu, np. scenariusza w Curriculum).
+    // Po reset() pojedynczych rakiet trzeba ją wywołać ręcznie
+    void activateAll(int segment = 0)
+    {
+        if (segment <= 0)
+            segment = size;
+        chunkBegin.clear();
+        for (int s = 0; s < size; s += segment)
+            for (int b = s; b < std::min(size, s + segment); b += STEP_GRAIN)
+                chunkBegin.push_back(b);
+        chunkBegin.push_back(size);
+
+        chunkActive.assign(chunkBegin.size() - 1, 0);
+        for (int c = 0; c < chunkCount(); ++c)
+        {
+            int count = 0;
+            for (int i = chunkBegin[c]; i < chunkBegin[c + 1]; ++i)
+                if (isActive(i))
+                    activeIds[chunkBegin[c] + count++] = i;
+            chunkActive[c] = count;
+        }
+    }
+
+    int chunkCount() const { return (int)chunkBegin.size() - 1; }
+
+    bool isActive(int i) const { return !dead[i] && !completed[i]; }
+
+    int checkpointsVisited(int i) const { return (int)std::bitset<32>(visitedCheckpoints[i]).count(); }
+
+    Real *genome(int i) { return genomes.data() + (size_t)i * genomeSize; }
+    const Real *genome(int i) const { return genomes.data() + (size_t)i * genomeSize; }
+
+    float *lasersOf(int i) { return laserDist.data() + (size_t)i * laserCount; }
+    const float *lasersOf(int i) const { return laserDist.data() + (size_t)i * laserCount; }
+};
+
+// maska z ustawionymi bitami wszystkich n checkpointów
+inline std::uint32_t allCheckpointsMask(int n)
+{
+    return n >= 32 ? 0xFFFFFFFFu : ((1u << n) - 1u);
+}
+
+#endif // POPULATION_H
@@ -0,0 +1,324 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define ROCKETS_PROFILE_TSC 1
+#endif
+
+// Pomiar czasu faz symulacji (cmake -DROCKETS_PROFILE=ON).
+// Bez ROCKETS_PROFILE makra PROFILE_* rozwijają się do niczego, więc pomiar nic nie kosztuje.
+// Z nim każda faza kroku jest mierzona raz na porcję rakiet (STEP_GRAIN), a nie na rakietę - licznik
+// cykli procesora (rdtsc) i sumy w tablicach wątku bez blokad, więc narzut jest daleko poniżej 1%.
+// Sumy są zbierane co pokolenie i dopisywane do pliku CSV albo JSON (jeden obiekt na wiersz),
+// a dla wybranego okna kroków można zapisać ślad w formacie Chrome trace_event (chrome://tracing, Perfetto).
+
+enum class Phase : int
+{
+    Sense,
+    Checkpoints,
+    Think,
+    Physics,
+    Collision,
+    Fitness,
+    Evolve,
+    Render,
+    Count
+};
+
+const int PHASE_COUNT = (int)Phase::Count;
+
+inline const char *phaseName(Phase phase)
+{
+    static const char *names[PHASE_COUNT] = {"sense", "checkpoints", "think", "physics", "collision", "fitness", "evolve", "render"};
+    return names[(int)phase];
+}
+
+#ifdef ROCKETS_PROFILE
+const bool PROFILING_ENABLED = true;
+#else
+const bool PROFILING_ENABLED = false;
+#endif
+
+// Znacznik czasu: cykle procesora (x86) albo nanosekundy zegara monotonicznego
+inline std::uint64_t profileClock()
+{
+#ifdef ROCKETS_PROFILE_TSC
+    return __rdtsc();
+#else
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Jedno zdarzenie śladu (czasy w jednostkach profileClock())
+struct TraceEvent
+{
+    Phase phase;
+    std::uint64_t start;
+    std::uint64_t duration;
+};
+
+// Sumy faz jednego wątku. Pisze tylko wątek-właściciel (load + store bez instrukcji atomowych RMW),
+// a czytać może dowolny wątek
+struct PhaseCounters
+{
+    std::array<std::atomic<std::uint64_t>, PHASE_COUNT> ticks{};
+    std::array<std::atomic<std::uint64_t>, PHASE_COUNT> items{};
+    int thread = 0;
+
+    std::mutex traceMutex; // tylko dla zdarzeń śladu, w oknie śledzenia
+    std::vector<TraceEvent> trace;
+};
+
+// Sumy faz całego programu (albo jednego pokolenia)
+struct PhaseTotals
+{
+    std::array<std::uint64_t, PHASE_COUNT> ticks{};
+    std::array<std::uint64_t, PHASE_COUNT> items{};
+};
+
+class Profiler
+{
+public:
+    Profiler() : startClock(profileClock()), startTime(std::chrono::steady_clock::now()) {}
+
+    Profiler(const Profiler &) = delete;
+    Profiler &operator=(const Profiler &) = delete;
+
+    // Dodaje czas fazy [start, end) i liczbę przetworzonych elementów (np. rakiet) do sum bieżącego wątku
+    void record(Phase phase, std::uint64_t start, std::uint64_t end, std::uint64_t items)
+    {
+        PhaseCounters &c = local();
+        const int p = (int)phase;
+        c.ticks[p].store(c.ticks[p].load(std::memory_order_relaxed) + (end - start), std::memory_order_relaxed);
+        c.items[p].store(c.items[p].load(std::memory_order_relaxed) + items, std::memory_order_relaxed);
+        if (tracing.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(c.traceMutex);
+            c.trace.push_back({phase, start, end - start});
+        }
+    }
+
+    // Koniec kroku symulacji - licznik kroków wyznacza okno śladu.
+    // Może być wołane z wielu wątków naraz (model wyspowy): licznik jest atomowy, a początek i koniec okna
+    // obsługuje pod traceWindowMutex dokładnie jeden wątek - ten, któremu przypadł dany numer kroku
+    void tick()
+    {
+        const std::uint64_t t = currentTick.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (!traceArmed.load(std::memory_order_acquire))
+            return;
+        if (t != traceFrom && t != traceFrom + traceTicks)
+            return;
+
+        std::lock_guard<std::mutex> lock(traceWindowMutex);
+        if (t == traceFrom && !tracing)
+        {
+            traceStart = profileClock();
+            tracing = true;
+        }
+        else if (t == traceFrom + traceTicks)
+        {
+            // wątek z krokiem końcowym mógł wyprzedzić wątek z początkowym - ślad jest wtedy pusty
+            traceArmed = false;
+            tracing = false;
+            writeTrace();
+        }
+    }
+
+    // Otwiera dziennik pokoleń: plik .csv dostaje CSV, każdy inny - JSON (jeden obiekt na pokolenie w wierszu)
+    bool openLog(const std::string &path)
+    {
+        log.open(path, std::ios::out | std::ios::trunc);
+        if (!log)
+        {
+            std::cerr << "Nie można otworzyć pliku pomiarów: " << path << std::endl;
+            return false;
+        }
+        csv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+        if (csv)
+            log << "generation,phase,ms,items,ns_per_item\n";
+        return true;
+    }
+
+    // Zapisuje ślad kroków [from, from + count) (licząc od 1) do pliku w formacie Chrome trace_event
+    void startTrace(const std::string &path, std::uint64_t from, std::uint64_t count)
+    {
+        std::lock_guard<std::mutex> lock(traceWindowMutex);
+        tracePath = path;
+        traceFrom = std::max<std::uint64_t>(from, currentTick.load() + 1);
+        traceTicks = std::max<std::uint64_t>(count, 1);
+        traceArmed.store(true, std::memory_order_release); // publikuje traceFrom/traceTicks dla tick()
+    }
+
+    // Sumy ze wszystkich wątków od startu programu
+    PhaseTotals totals()
+    {
+        PhaseTotals t;
+        std::lock_guard<std::mutex> lock(registryMutex);
+        for (PhaseCounters &c : threads)
+            for (int p = 0; p < PHASE_COUNT; ++p)
+            {
+                t.ticks[p] += c.ticks[p].load(std::memory_order_relaxed);
+                t.items[p] += c.items[p].load(std::memory_order_relaxed);
+            }
+        return t;
+    }
+
+    // Koniec pokolenia - sumy od poprzedniego wywołania trafiają do dziennika
+    void endGeneration(int generation)
+    {
+        PhaseTotals now = totals();
+        if (log.is_open())
+        {
+            const double ns = nsPerTick();
+            if (!csv)
+                log << "{\"generation\":" << generation << ",\"phases\":{";
+            for (int p = 0; p < PHASE_COUNT; ++p)
+            {
+                const double ms = (now.ticks[p] - lastTotals.ticks[p]) * ns / 1e6;
+                const std::uint64_t items = now.items[p] - lastTotals.items[p];
+                if (csv)
+                    log << generation << ',' << phaseName((Phase)p) << ',' << ms << ',' << items << ','
+                        << (items ? ms * 1e6 / items : 0.0) << '\n';
+                else
+                    log << (p ? "," : "") << '"' << phaseName((Phase)p) << "\":{\"ms\":" << ms << ",\"items\":" << items << '}';
+            }
+            if (!csv)
+                log << "}}\n";
+        }
+        lastTotals = now;
+    }
+
+    // Nanosekundy na jednostkę profileClock() (dla rdtsc kalibrowane względem zegara monotonicznego)
+    double nsPerTick()
+    {
+#ifdef ROCKETS_PROFILE_TSC
+        auto elapsed = std::chrono::steady_clock::now() - startTime;
+        if (elapsed < std::chrono::milliseconds(10))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10) - elapsed);
+            elapsed = std::chrono::steady_clock::now() - startTime;
+        }
+        const std::uint64_t cycles = profileClock() - startClock;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / (double)cycles;
+#else
+        return 1.0;
+#endif
+    }
+
+private:
+    PhaseCounters &local()
+    {
+        thread_local PhaseCounters *counters = registerThread();
+        return *counters;
+    }
+
+    PhaseCounters *registerThread()
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threads.emplace_back();
+        threads.back().thread = (int)threads.size();
+        return &threads.back();
+    }
+
+    void writeTrace()
+    {
+        const double us = nsPerTick() / 1000.0;
+        std::ostringstream out;
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        std::lock_guard<std::mutex> registryLock(registryMutex);
+        for (PhaseCounters &c : threads)
+        {
+            std::lock_guard<std::mutex> lock(c.traceMutex);
+            for (const TraceEvent &e : c.trace)
+            {
+                out << (first ? "" : ",") << "\n{\"name\":\"" << phaseName(e.phase) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << c.thread
+                    << ",\"ts\":" << (double)(std::int64_t)(e.start - traceStart) * us << ",\"dur\":" << (double)e.duration * us << '}';
+                first = false;
+            }
+            c.trace.clear();
+            c.trace.shrink_to_fit();
+        }
+        out << "\n]}\n";
+
+        std::ofstream file(tracePath, std::ios::out | std::ios::trunc);
+        if (!(file << out.str()))
+            std::cerr << "Nie można zapisać śladu: " << tracePath << std::endl;
+    }
+
+    std::mutex registryMutex;
+    std::deque<PhaseCounters> threads; // deque - adresy liczników nie zmieniają się przy dodawaniu wątków
+    PhaseTotals lastTotals;
+
+    std::ofstream log;
+    bool csv = false;
+
+    std::atomic<bool> tracing{false};
+    std::atomic<bool> traceArmed{false}; // okno śladu ustawione i jeszcze niezapisane
+    std::mutex traceWindowMutex;          // tracePath, traceStart i zapis śladu
+    std::string tracePath;
+    std::uint64_t traceFrom = 0;
+    std::uint64_t traceTicks = 0;
+    std::uint64_t traceStart = 0;
+    std::atomic<std::uint64_t> currentTick{0};
+
+    std::uint64_t startClock;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+inline Profiler &profiler()
+{
+    static Profiler instance;
+    return instance;
+}
+
+// Mierzy czas od utworzenia do końca zakresu
+class ProfileScope
+{
+public:
+    explicit ProfileScope(Phase phase, std::uint64_t items = 1) : phase(phase), items(items), start(profileClock()) {}
+    ~ProfileScope() { profiler().record(phase, start, profileClock(), items); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    Phase phase;
+    std::uint64_t items;
+    std::uint64_t start;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ROCKETS_PROFILE
+// Mierzy fazę do końca bieżącego zakresu; items - liczba przetworzonych elementów (np. rakiet)
+#define PROFILE_SCOPE(phase, items) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(phase, items)
+#define PROFILE_TICK() profiler().tick()
+#define PROFILE_GENERATION(generation) profiler().endGeneration(generation)
+#else
+#define PROFILE_SCOPE(phase, items) ((void)0)
+#define PROFILE_TICK() ((void)0)
+#define PROFILE_GENERATION(generation) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,171 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+// SplitMix64 - rozprowadza ziarno na stan generatora (i miesza numery strumieni)
+inline std::uint64_t splitMix64(std::uint64_t &state)
+{
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Generator xoshiro256** - szybki, o małym stanie (32 bajty), więc tani do tworzenia dla każdego osobnika
+class Rng
+{
+public:
+    explicit Rng(std::uint64_t seed = 0)
+    {
+        std::uint64_t sm = seed;
+        for (auto &word : s)
+            word = splitMix64(sm);
+    }
+
+    // Niezależny strumień wyznaczony przez ziarno i dwa numery (np. pokolenie i numer dziecka).
+    // Ten sam strumień daje te same liczby niezależnie od tego, który wątek go używa
+    static Rng stream(std::uint64_t seed, std::uint64_t a, std::uint64_t b = 0)
+    {
+        std::uint64_t sm = seed;
+        std::uint64_t key = splitMix64(sm) ^ a;
+        key = splitMix64(key) ^ b;
+        return Rng(splitMix64(key));
+    }
+
+    std::uint64_t next()
+    {
+        const std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // liczba z zakresu [0, 1) z 53 bitów losowych
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // liczba z zakresu [min, max)
+    double range(double min, double max) { return min + uniform() * (max - min); }
+
+    // liczba całkowita z zakresu [0, n) bez obciążenia modulo (metoda Lemire'a)
+    std::uint32_t below(std::uint32_t n)
+    {
+        std::uint64_t m = (std::uint64_t)(std::uint32_t)(next() >> 32) * n;
+        std::uint32_t low = (std::uint32_t)m;
+        if (low < n)
+        {
+            std::uint32_t threshold = (0u - n) % n;
+            while (low < threshold)
+            {
+                m = (std::uint64_t)(std::uint32_t)(next() >> 32) * n;
+                low = (std::uint32_t)m;
+            }
+        }
+        return (std::uint32_t)(m >> 32);
+    }
+
+private:
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    std::uint64_t s[4];
+};
+
+// Centralny system liczb losowych.
+// Wszystkie strumienie wyprowadzane są z jednego ziarna głównego (master seed), więc przebieg z tym samym ziarnem
+// jest powtarzalny. Kod równoległy używa strumieni przypisanych do danych (Rng::stream), a nie do wątków;
+// threadRng() służy do pojedynczych losowań poza gorącymi pętlami i jest bezpieczny wątkowo.
+
+// numery strumieni dla poszczególnych zastosowań ziarna głównego
+const std::uint64_t STREAM_INIT_WEIGHTS = 1;
+const std::uint64_t STREAM_EVOLVE = 2;
+const std::uint64_t STREAM_THREAD = 3;
+const std::uint64_t STREAM_CURRICULUM = 4;
+const std::uint64_t STREAM_ISLAND = 5;
+
+// przechowuje ziarno główne oraz licznik jego zmian (żeby generatory wątków wiedziały, kiedy się przelosować)
+struct MasterSeed
+{
+    std::atomic<std::uint64_t> seed{std::random_device{}()};
+    std::atomic<std::uint64_t> version{0};
+    std::atomic<std::uint64_t> threadCounter{0};
+};
+
+inline MasterSeed &masterSeedState()
+{
+    static MasterSeed state;
+    return state;
+}
+
+inline std::uint64_t masterSeed() { return masterSeedState().seed.load(std::memory_order_relaxed); }
+
+// Ustawia ziarno główne - wywoływać na starcie, przed tworzeniem populacji
+inline void setMasterSeed(std::uint64_t seed)
+{
+    MasterSeed &state = masterSeedState();
+    state.seed.store(seed);
+    state.threadCounter.store(0);
+    state.version.fetch_add(1);
+}
+
+// Generator bieżącego wątku - własny strumień dla każdego wątku, przelosowany po zmianie ziarna głównego
+inline Rng &threadRng()
+{
+    thread_local Rng rng;
+    thread_local std::uint64_t seenVersion = ~0ull;
+    MasterSeed &state = masterSeedState();
+    std::uint64_t version = state.version.load(std::memory_order_acquire);
+    if (version != seenVersion)
+    {
+        seenVersion = version;
+        rng = Rng::stream(state.seed.load(), STREAM_THREAD, state.threadCounter.fetch_add(1));
+    }
+    return rng;
+}
+
+// Wypełnia bufor liczbami z zakresu [min, max) - inicjalizacja wag
+template <class T>
+inline void fillUniform(Rng &rng, T *out, std::size_t n, double min, double max)
+{
+    const double scale = (max - min) * (1.0 / 9007199254740992.0);
+    for (std::size_t i = 0; i < n; ++i)
+        out[i] = (T)(min + (rng.next() >> 11) * scale);
+}
+
+// Mutacja: każdy gen z prawdopodobieństwem `rate` dostaje szum z zakresu [-strength, strength) i jest przycinany do [-1, 1].
+// Zamiast losować dla każdego genu, losowana jest odległość do następnego mutowanego genu (rozkład geometryczny),
+// więc koszt zależy od liczby mutacji, a nie od długości genotypu
+template <class T>
+inline void mutateSparse(Rng &rng, T *genes, std::size_t n, double rate, double strength)
+{
+    if (rate <= 0.0)
+        return;
+    const double logKeep = rate < 1.0 ? std::log(1.0 - rate) : 0.0;
+    std::size_t i = 0;
+    while (true)
+    {
+        if (rate < 1.0)
+        {
+            // 1 - uniform() jest w (0, 1], więc logarytm jest skończony
+            double skip = std::floor(std::log(1.0 - rng.uniform()) / logKeep);
+            if (skip >= (double)(n - i))
+                return;
+            i += (std::size_t)skip;
+        }
+        if (i >= n)
+            return;
+        double gene = genes[i] + rng.range(-strength, strength);
+        genes[i] = (T)(gene < -1.0 ? -1.0 : (gene > 1.0 ? 1.0 : gene));
+        ++i;
+    }
+}
+
+#endif // RANDOM_H
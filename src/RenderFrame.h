@@ -0,0 +1,72 @@
+#ifndef RENDER_FRAME_H
+#define RENDER_FRAME_H
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+
+#include "Population.h"
+#include "Rocket.h"
+#include "Simulation.h"
+
+// Niezmienny obraz stanu symulacji do narysowania - wszystko, czego potrzebuje Renderer, bez dostępu do Population.
+// Wątek symulacji wypełnia go po swoich krokach i publikuje przez TripleBuffer, a wątek rysujący czyta
+// ostatni opublikowany obraz, więc rysowanie nigdy nie zatrzymuje symulacji ani nie czyta jej w trakcie kroku.
+struct RenderFrame
+{
+    int size = 0;
+    int laserCount = 0;
+    int bestIdx = -1;
+    int generation = 0;
+    int timer = 0;
+
+    std::vector<float> posX, posY;
+    std::vector<float> rotation;
+    std::vector<std::uint8_t> dead;
+    std::vector<std::uint8_t> thrusting;
+    std::vector<double> score; // do wyboru najlepszych rakiet do rysowania (jak w findBestRocket)
+
+    // końce laserów w układzie ekranu [size * laserCount]
+    std::vector<float> laserEndX, laserEndY;
+    std::vector<std::uint8_t> laserHit;
+};
+
+// Kopiuje stan populacji do obrazu. Bufory obrazu są alokowane tylko przy pierwszym użyciu (lub zmianie rozmiaru)
+inline void captureFrame(const Population &pop, RenderFrame &frame, int generation, int timer)
+{
+    const size_t n = pop.size;
+    const size_t lasers = n * pop.laserCount;
+    frame.size = pop.size;
+    frame.laserCount = pop.laserCount;
+    frame.generation = generation;
+    frame.timer = timer;
+    frame.bestIdx = findBestRocket(pop);
+
+    frame.posX.assign(pop.posX.begin(), pop.posX.end());
+    frame.posY.assign(pop.posY.begin(), pop.posY.end());
+    frame.rotation.assign(pop.rotation.begin(), pop.rotation.end());
+    frame.dead.assign(pop.dead.begin(), pop.dead.end());
+    frame.thrusting.assign(pop.thrusting.begin(), pop.thrusting.end());
+    frame.laserHit.assign(pop.laserHit.begin(), pop.laserHit.end());
+    frame.score.resize(n);
+    frame.laserEndX.resize(lasers);
+    frame.laserEndY.resize(lasers);
+
+    const std::vector<float> &angles = experiment().laserAngles;
+    for (int i = 0; i < pop.size; ++i)
+    {
+        frame.score[i] = pop.dead[i] ? -1e18 : pop.checkpointsVisited(i) * 10000.0 - pop.bestDistanceToTarget[i];
+
+        // koniec promienia z pozycji, obrotu i zmierzonej odległości
+        const float *dist = pop.lasersOf(i);
+        for (int l = 0; l < pop.laserCount; ++l)
+        {
+            float rad = (pop.rotation[i] - 90.f + angles[l]) * 3.14159f / 180.f;
+            size_t k = (size_t)i * pop.laserCount + l;
+            frame.laserEndX[k] = pop.posX[i] + std::cos(rad) * dist[l];
+            frame.laserEndY[k] = pop.posY[i] + std::sin(rad) * dist[l];
+        }
+    }
+}
+
+#endif // RENDER_FRAME_H
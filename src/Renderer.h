@@ -0,0 +1,239 @@
+#ifndef RENDERER_H
+#define RENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+#include "World.h"
+#include "RenderFrame.h"
+#include "Random.h"
+
+// ile rakiet rysować w trybach DrawMode::Top i DrawMode::Sample
+const int RENDER_SUBSET = 25;
+
+enum class DrawMode
+{
+    All,
+    Top,   // RENDER_SUBSET rakiet z najlepszym wynikiem
+    Sample // stała losowa próbka RENDER_SUBSET rakiet
+};
+
+inline const char *drawModeName(DrawMode mode)
+{
+    switch (mode)
+    {
+    case DrawMode::Top:
+        return "top";
+    case DrawMode::Sample:
+        return "sample";
+    default:
+        return "all";
+    }
+}
+
+// kolejny tryb przy przełączaniu klawiszem: wszystkie -> najlepsze -> próbka -> wszystkie
+inline DrawMode nextDrawMode(DrawMode mode)
+{
+    return mode == DrawMode::All ? DrawMode::Top : (mode == DrawMode::Top ? DrawMode::Sample : DrawMode::All);
+}
+
+// Rysowanie świata i populacji. Stan symulacji nie zna SFML - wierzchołki są budowane dopiero tutaj z obrazu RenderFrame,
+// po jednej tablicy wierzchołków na rodzaj obiektu (przeszkody, checkpointy, płomienie, kadłuby, lasery)
+class Renderer
+{
+public:
+    Renderer(const World &world, const sf::Texture &shipTexture, const sf::Texture &fireTexture)
+        : shipTexture(&shipTexture), fireTexture(&fireTexture)
+    {
+        // sprite'y rysowane są w skali x2; kadłub obraca się wokół środka, płomień wokół punktu (8, 2)
+        shipSize = sf::Vector2f(shipTexture.getSize());
+        shipOrigin = shipSize / 2.f;
+        fireSize = sf::Vector2f(fireTexture.getSize());
+        fireOrigin = {8.f, 2.f};
+
+        // świat się nie zmienia - przeszkody i checkpointy są budowane raz, każdy rodzaj w jednej tablicy trójkątów
+        for (const Box &b : world.przeszkody)
+            appendRect(przeszkody, b, sf::Color::Black);
+        for (const Box &b : world.checkpoints)
+            appendCircle(checkpoints, {(b.minX + b.maxX) / 2.f, (b.minY + b.maxY) / 2.f}, (b.maxX - b.minX) / 2.f,
+                         sf::Color(100, 150, 200, 150));
+        cel.setRadius(world.celRadius);
+        cel.setFillColor(sf::Color::Green);
+        cel.setOrigin({world.celRadius, world.celRadius});
+        cel.setPosition(world.cel);
+    }
+
+    void drawWorld(sf::RenderWindow &win)
+    {
+        win.draw(checkpoints);
+        win.draw(cel);
+        win.draw(przeszkody);
+    }
+
+    // Rysuje rakiety dwoma wywołaniami draw: wszystkie płomienie w jednej tablicy wierzchołków i wszystkie kadłuby w drugiej
+    // (po dwa trójkąty na prostokąt sprite'a). Martwe rakiety są pomijane, najlepsza (zielona) jest zawsze rysowana na wierzchu
+    void drawRockets(sf::RenderWindow &win, const RenderFrame &frame)
+    {
+        const int bestIdx = frame.bestIdx;
+        selectRockets(frame);
+        flames.clear();
+        ships.clear();
+        for (int i : selection)
+        {
+            if (frame.dead[i] && i != bestIdx)
+                continue;
+            if (frame.thrusting[i] && !frame.dead[i])
+            {
+                float angleRad = (frame.rotation[i] - 90.f) * 3.14159f / 180.f;
+                float offsetDist = 32.0f;
+                appendQuad(flames, {frame.posX[i] - std::cos(angleRad) * offsetDist, frame.posY[i] - std::sin(angleRad) * offsetDist},
+                           frame.rotation[i], fireSize, fireOrigin, sf::Color::White);
+            }
+            if (i != bestIdx)
+                appendQuad(ships, {frame.posX[i], frame.posY[i]}, frame.rotation[i], shipSize, shipOrigin, sf::Color(255, 255, 255, 100));
+        }
+        if (bestIdx >= 0 && bestIdx < frame.size)
+            appendQuad(ships, {frame.posX[bestIdx], frame.posY[bestIdx]}, frame.rotation[bestIdx], shipSize, shipOrigin, sf::Color::Green);
+
+        win.draw(flames, sf::RenderStates(fireTexture));
+        win.draw(ships, sf::RenderStates(shipTexture));
+    }
+
+    // Rysowanie laserów żywych rakiet z bieżącego wyboru (drawRockets) - jedna tablica linii, jedno wywołanie draw
+    void drawLasers(sf::RenderWindow &win, const RenderFrame &frame)
+    {
+        lasers.clear();
+        for (int i : selection)
+        {
+            if (frame.dead[i])
+                continue;
+            sf::Vector2f origin = {frame.posX[i], frame.posY[i]};
+            for (int l = 0; l < frame.laserCount; ++l)
+            {
+                size_t k = (size_t)i * frame.laserCount + l;
+                sf::Color laserColor = frame.laserHit[k] ? sf::Color::Red : sf::Color(150, 150, 150, 100); // Czerwony gdy trafiony, szary gdy nie
+                lasers.append(sf::Vertex{origin, laserColor});
+                lasers.append(sf::Vertex{{frame.laserEndX[k], frame.laserEndY[k]}, laserColor});
+            }
+        }
+        win.draw(lasers);
+    }
+
+    // Które rakiety rysować: wszystkie, N najlepszych albo stała losowa próbka N rakiet
+    void setDrawMode(DrawMode mode, int count = RENDER_SUBSET)
+    {
+        drawMode = mode;
+        drawCount = count;
+    }
+    DrawMode getDrawMode() const { return drawMode; }
+
+private:
+    void selectRockets(const RenderFrame &frame)
+    {
+        const int bestIdx = frame.bestIdx;
+        selection.clear();
+        if (drawMode == DrawMode::All || drawCount >= frame.size)
+        {
+            for (int i = 0; i < frame.size; ++i)
+                selection.push_back(i);
+            return;
+        }
+        if (drawMode == DrawMode::Top)
+        {
+            order.resize(frame.size);
+            std::iota(order.begin(), order.end(), 0);
+            std::partial_sort(order.begin(), order.begin() + drawCount, order.end(), [&](int a, int b)
+                              { return frame.score[a] > frame.score[b]; });
+            selection.assign(order.begin(), order.begin() + drawCount);
+        }
+        else
+        {
+            // próbka losowana raz dla danego rozmiaru populacji, żeby nie migotała między klatkami.
+            // Własny generator - rysowanie nie zużywa liczb losowych symulacji
+            if ((int)sample.size() != frame.size)
+            {
+                sample.resize(frame.size);
+                std::iota(sample.begin(), sample.end(), 0);
+                Rng rng(0x5EED);
+                for (int k = frame.size - 1; k > 0; --k)
+                    std::swap(sample[k], sample[rng.below((std::uint32_t)k + 1)]);
+            }
+            selection.assign(sample.begin(), sample.begin() + drawCount);
+        }
+        if (bestIdx >= 0 && std::find(selection.begin(), selection.end(), bestIdx) == selection.end())
+            selection.push_back(bestIdx);
+    }
+
+    // Dopisuje prostokąt tekstury (size, punkt zaczepienia origin, skala x2) obrócony o rotation stopni wokół pos
+    static void appendQuad(sf::VertexArray &va, sf::Vector2f pos, float rotation, sf::Vector2f size, sf::Vector2f origin, sf::Color color)
+    {
+        float rad = rotation * 3.14159f / 180.f;
+        float c = std::cos(rad) * 2.f;
+        float s = std::sin(rad) * 2.f;
+        const sf::Vector2f corners[4] = {{0.f, 0.f}, {size.x, 0.f}, {size.x, size.y}, {0.f, size.y}};
+        sf::Vertex v[4];
+        for (int k = 0; k < 4; ++k)
+        {
+            float x = corners[k].x - origin.x;
+            float y = corners[k].y - origin.y;
+            v[k] = sf::Vertex{{pos.x + x * c - y * s, pos.y + x * s + y * c}, color, corners[k]};
+        }
+        va.append(v[0]);
+        va.append(v[1]);
+        va.append(v[2]);
+        va.append(v[0]);
+        va.append(v[2]);
+        va.append(v[3]);
+    }
+
+    // Dopisuje prostokąt osiowy jako dwa trójkąty
+    static void appendRect(sf::VertexArray &va, const Box &b, sf::Color color)
+    {
+        const sf::Vertex v[4] = {{{b.minX, b.minY}, color}, {{b.maxX, b.minY}, color}, {{b.maxX, b.maxY}, color}, {{b.minX, b.maxY}, color}};
+        va.append(v[0]);
+        va.append(v[1]);
+        va.append(v[2]);
+        va.append(v[0]);
+        va.append(v[2]);
+        va.append(v[3]);
+    }
+
+    // Dopisuje koło jako wachlarz trójkątów (tyle boków, ile domyślnie ma sf::CircleShape)
+    static void appendCircle(sf::VertexArray &va, sf::Vector2f center, float radius, sf::Color color)
+    {
+        const int sides = 30;
+        sf::Vector2f prev = {center.x, center.y - radius};
+        for (int k = 1; k <= sides; ++k)
+        {
+            float rad = k * 2.f * 3.14159265f / sides;
+            sf::Vector2f next = {center.x + std::sin(rad) * radius, center.y - std::cos(rad) * radius};
+            va.append(sf::Vertex{center, color});
+            va.append(sf::Vertex{prev, color});
+            va.append(sf::Vertex{next, color});
+            prev = next;
+        }
+    }
+
+    const sf::Texture *shipTexture;
+    const sf::Texture *fireTexture;
+    sf::Vector2f shipSize, shipOrigin;
+    sf::Vector2f fireSize, fireOrigin;
+    sf::VertexArray ships{sf::PrimitiveType::Triangles};
+    sf::VertexArray flames{sf::PrimitiveType::Triangles};
+    sf::VertexArray lasers{sf::PrimitiveType::Lines};
+
+    DrawMode drawMode = DrawMode::All;
+    int drawCount = RENDER_SUBSET;
+    std::vector<int> selection;
+    std::vector<int> order;
+    std::vector<int> sample;
+
+    sf::VertexArray przeszkody{sf::PrimitiveType::Triangles};
+    sf::VertexArray checkpoints{sf::PrimitiveType::Triangles};
+    sf::CircleShape cel;
+};
+
+#endif // RENDERER_H
@@ -1,444 +1,301 @@
 #ifndef ROCKET_H
 #define ROCKET_H
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <cmath>
 #include <vector>
 #include <algorithm>
 
-#include "siec/Neuron.h"
-#include "siec/Matrix.h"
-#include "siec/NeuralNetwork.h"
-#include "siec/utils/MultiplyMatrix.h"
+#include "siec/BatchedNetwork.h"
 
-#include "LaserReading.h"
+#include "Population.h"
+#include "World.h"
+#include "Sensor.h"
 #include "Utils.h"
+#include "Config.h"
 
 // stała do obliczen
 const double M_PI_VAL = 3.14159265358979323846;
 
-// struktura rakiety
-struct Rocket
+// parametry fizyczne, lasery i topologia sieci (domyślnie 13 wejść, 8 neuronów ukrytych i 3 wyjścia)
+// ustawiane przy starcie programu - ExperimentConfig w Config.h
+
+// wymiary rakieta.png po przeskalowaniu x2 - hitbox rakiety (origin w środku sprite'a)
+const float SHIP_WIDTH = 32.f;
+const float SHIP_HEIGHT = 64.f;
+
+// sprowadza kąt w stopniach do zakresu [0, 360), tak jak sf::Transformable::setRotation
+inline float wrapDegrees(float angle)
 {
-    // konfiguracja
-    sf::Vector2f velocity = {0.f, 0.f};
-    sf::Sprite sprite;
-    sf::Sprite fireSprite;
-    std::vector<LaserReading> lasers;
-
-    // stan
-    NeuralNetwork *brain = nullptr;
-    double fitness = 0.0;
-    bool dead = false;
-    bool completed = false;
-    bool isThrusting = false;
-
-    // statystyki
-    int timeAlive = 0;
-    std::vector<bool> visitedCheckpoints;
-    float bestDistanceToTarget = 999999.f; // Resetowane przy każdym checkpoincie
-    sf::Vector2f lastPosition = {0.f, 0.f};
-    int stuckCounter = 0;
-
-    // parametry fizyczne
-    const float gravity = 0.02f;
-    const float thrustPower = 0.1f;
-    const float rotationSpeed = 3.0f;
-    const float maxLaserDist = 400.0f;
-    std::vector<float> laserAngles = {-90.f, -45.f, -20.f, 0.f, 20.f, 45.f, 90.f, 180.f};
-
-    // topologia sieci neuronowej, 13 wejsc, 8 warstw ukrytych i 3 wyjscia
-    const std::vector<int> topology = {13, 8, 3};
-
-    // skalowanie raycastów (laserów) oraz tekstur rakiety (i inicjacja sieci)
-    Rocket(const sf::Texture &shipTexture, const sf::Texture &fireTexture, bool initBrain = true)
-        : sprite(shipTexture), fireSprite(fireTexture)
-    {
-        lasers.resize(laserAngles.size());
-        fireSprite.setOrigin({8.f, 2.f});
-        fireSprite.setScale({2.0f, 2.0f});
-        sf::FloatRect spriteBounds = sprite.getLocalBounds();
-        sprite.setOrigin(spriteBounds.getCenter());
-        sprite.setScale({2.0f, 2.0f});
-
-        if (initBrain)
-        {
-            brain = new NeuralNetwork(topology);
-        }
-    }
+    float val = angle - static_cast<float>(static_cast<int>(angle / 360.f)) * 360.f;
+    return val >= 0.f ? val : val + 360.f;
+}
 
-    // konstruktor kopiujacy zeby tworzyc nowa rakiete
-    Rocket(const Rocket &other) : sprite(other.sprite), fireSprite(other.fireSprite), topology(other.topology)
+// Prostokąt otaczający obróconą rakietę - odpowiednik sprite.getGlobalBounds()
+inline Box rocketBounds(const Population &pop, int i)
+{
+    float rad = pop.rotation[i] * 3.14159f / 180.f;
+    float c = std::abs(std::cos(rad));
+    float s = std::abs(std::sin(rad));
+    float ex = 0.5f * (c * SHIP_WIDTH + s * SHIP_HEIGHT);
+    float ey = 0.5f * (s * SHIP_WIDTH + c * SHIP_HEIGHT);
+    return {pop.posX[i] - ex, pop.posY[i] - ey, pop.posX[i] + ex, pop.posY[i] + ey};
+}
+
+// Odpowiada za podstawową fizykę: dodaje grawitację do prędkości, przesuwa obiekt i wyhamowuje go (tarcie). Zawiera też mechanizm wykrywający "utknięcie" w miejscu (jeśli rakieta się nie rusza, zostaje uśmiercona)
+inline void updatePhysics(Population &pop, int i)
+{
+    if (!pop.isActive(i))
+        return;
+
+    const ExperimentConfig &cfg = experiment();
+    pop.velY[i] += cfg.gravity;
+    pop.posX[i] += pop.velX[i];
+    pop.posY[i] += pop.velY[i];
+    pop.velX[i] *= cfg.drag;
+    pop.velY[i] *= cfg.drag;
+
+    // wykrywanie utknięcia
+    if (pop.timeAlive[i] % 100 == 0)
     {
-        lasers = other.lasers;
-        velocity = other.velocity;
-        fitness = other.fitness;
-        dead = other.dead;
-        completed = other.completed;
-        isThrusting = other.isThrusting;
-        visitedCheckpoints = other.visitedCheckpoints;
-        timeAlive = other.timeAlive;
-        bestDistanceToTarget = other.bestDistanceToTarget;
-        stuckCounter = other.stuckCounter;
-        lastPosition = other.lastPosition;
-
-        if (other.brain)
+        float dx = pop.posX[i] - pop.lastPosX[i];
+        float dy = pop.posY[i] - pop.lastPosY[i];
+        float distMoved = std::sqrt(dx * dx + dy * dy);
+
+        if (distMoved < 20.0f)
         {
-            brain = new NeuralNetwork(topology);
-            brain->setWeights(other.brain->getWeights());
+            pop.stuckCounter[i]++;
+            if (pop.stuckCounter[i] >= 3)
+            {
+                pop.dead[i] = 1;
+            }
         }
         else
         {
-            brain = nullptr;
+            pop.stuckCounter[i] = 0;
         }
+        pop.lastPosX[i] = pop.posX[i];
+        pop.lastPosY[i] = pop.posY[i];
     }
+}
 
-    // operator przypisania kopiującego
-    Rocket &operator=(const Rocket &other)
+// przygotowuje dane wejściowe sieci (odczyty laserów, prędkość, kąt do celu) znormalizowane do [-1, 1] i zapisuje je do wiersza partii.
+// Same obliczenia sieci dla całej populacji wykonuje BatchedNetwork, a wynik interpretuje applyControls()
+inline void buildInputs(Population &pop, int i, const World &world, Real *inputs)
+{
+    sf::Vector2f currentTarget = world.cel;
+    for (int c = 0; c < world.checkpointCount(); ++c)
     {
-        if (this == &other)
-            return *this;
-
-        sprite = other.sprite;
-        fireSprite = other.fireSprite;
-        lasers = other.lasers;
-        velocity = other.velocity;
-        fitness = other.fitness;
-        dead = other.dead;
-        completed = other.completed;
-        isThrusting = other.isThrusting;
-        visitedCheckpoints = other.visitedCheckpoints;
-        timeAlive = other.timeAlive;
-        bestDistanceToTarget = other.bestDistanceToTarget;
-        stuckCounter = other.stuckCounter;
-        lastPosition = other.lastPosition;
-
-        delete brain;
-        if (other.brain)
-        {
-            brain = new NeuralNetwork(topology);
-            brain->setWeights(other.brain->getWeights());
-        }
-        else
+        if (!(pop.visitedCheckpoints[i] & (1u << c)))
         {
-            brain = nullptr;
+            currentTarget = {world.checkpoints[c].minX, world.checkpoints[c].minY};
+            break;
         }
-        return *this;
     }
 
-    // destruktor
-    ~Rocket()
-    {
-        if (brain)
-            delete brain;
-    }
+    int k = 0;
 
-    // resetuje rakietę do nowej rundy (pokolenia). Resetuje pozycję, prędkość i flagi życia, ale zachowuje wytrenowany "mózg"
-    void reset(sf::Vector2f startPosition, int checkpointsCount)
+    // lasery [-1, 1]
+    const float *lasers = pop.lasersOf(i);
+    const float maxLaserDist = experiment().maxLaserDist;
+    for (int l = 0; l < pop.laserCount; ++l)
     {
-        dead = false;
-        completed = false;
-        isThrusting = false;
-        sprite.setPosition(startPosition);
-        sprite.setRotation(sf::degrees(0.f));
-        velocity = {0.f, 0.f};
-        fitness = 0.0;
-        timeAlive = 0;
-        bestDistanceToTarget = 999999.f;
-        stuckCounter = 0;
-        lastPosition = startPosition;
-        visitedCheckpoints.assign(checkpointsCount, false);
+        double normalized = lasers[l] / maxLaserDist;
+        inputs[k++] = (Real)(2.0 * normalized - 1.0);
     }
 
-    // Odpowiada za podstawową fizykę: dodaje grawitację do prędkości, przesuwa obiekt i wyhamowuje go (tarcie). Zawiera też mechanizm wykrywający "utknięcie" w miejscu (jeśli rakieta się nie rusza, zostaje uśmiercona)
-    void updatePhysics()
-    {
-        if (dead || completed)
-            return;
-
-        velocity.y += gravity;
-        sprite.move(velocity);
-        velocity *= 0.99f;
+    // prędkość [-1, 1]
+    double vx_norm = std::max(-1.0, std::min(1.0, pop.velX[i] / 4.0));
+    double vy_norm = std::max(-1.0, std::min(1.0, pop.velY[i] / 4.0));
+    inputs[k++] = (Real)vx_norm;
+    inputs[k++] = (Real)vy_norm;
 
-        // wykrywanie utknięcia
-        if (timeAlive % 100 == 0)
-        {
-            float distMoved = std::sqrt(
-                std::pow(sprite.getPosition().x - lastPosition.x, 2) +
-                std::pow(sprite.getPosition().y - lastPosition.y, 2));
+    // Nawigacja
+    double dx = currentTarget.x - pop.posX[i];
+    double dy = currentTarget.y - pop.posY[i];
+    double distToTarget = std::sqrt(dx * dx + dy * dy);
 
-            if (distMoved < 20.0f)
-            {
-                stuckCounter++;
-                if (stuckCounter >= 3)
-                {
-                    dead = true;
-                }
-            }
-            else
-            {
-                stuckCounter = 0;
-            }
-            lastPosition = sprite.getPosition();
-        }
-    }
-
-    // główna pętla decyzyjna AI. pobiera dane wejściowe (odczyty laserów, prędkość, kąt do celu), normalizuje je i przepuszcza przez sieć neuronową. wynik sieci decyduje o obrocie i włączeniu silnika.
-    void thinkAndMove(const std::vector<sf::CircleShape> &checkpoints, sf::Vector2f finalTarget)
+    // kluczowe: śledzimy najlepszy dystans do aktualnego celu
+    if (distToTarget < pop.bestDistanceToTarget[i])
     {
-        if (dead || completed)
-            return;
-
-        sf::Vector2f currentTarget = finalTarget;
-        for (size_t i = 0; i < checkpoints.size(); ++i)
-        {
-            if (!visitedCheckpoints[i])
-            {
-                currentTarget = checkpoints[i].getPosition();
-                break;
-            }
-        }
-
-        std::vector<double> inputs;
-
-        // lasery [-1, 1]
-        for (const auto &l : lasers)
-        {
-            double normalized = l.distance / maxLaserDist;
-            inputs.push_back(2.0 * normalized - 1.0);
-        }
-
-        // prędkość [-1, 1]
-        double vx_norm = std::max(-1.0, std::min(1.0, velocity.x / 4.0));
-        double vy_norm = std::max(-1.0, std::min(1.0, velocity.y / 4.0));
-        inputs.push_back(vx_norm);
-        inputs.push_back(vy_norm);
-
-        // Nawigacja
-        double dx = currentTarget.x - sprite.getPosition().x;
-        double dy = currentTarget.y - sprite.getPosition().y;
-        double distToTarget = std::sqrt(dx * dx + dy * dy);
-
-        // kluczowe: śledzimy najlepszy dystans do aktualnego celu
-        if (distToTarget < bestDistanceToTarget)
-        {
-            bestDistanceToTarget = distToTarget;
-        }
+        pop.bestDistanceToTarget[i] = distToTarget;
+    }
 
-        // dystans do celu [-1, 1]
-        double dist_normalized = std::min(1.0, distToTarget / 1500.0);
-        inputs.push_back(2.0 * dist_normalized - 1.0);
+    // dystans do celu [-1, 1]
+    double dist_normalized = std::min(1.0, distToTarget / 1500.0);
+    inputs[k++] = (Real)(2.0 * dist_normalized - 1.0);
 
-        // kąt do celu [-pi, pi]
-        double angleToTarget = std::atan2(dy, dx);
-        double currentAngle = (sprite.getRotation().asDegrees() - 90.0) * (M_PI_VAL / 180.0);
-        double angleDiff = angleToTarget - currentAngle;
+    // kąt do celu [-pi, pi]
+    double angleToTarget = std::atan2(dy, dx);
+    double currentAngle = (pop.rotation[i] - 90.0) * (M_PI_VAL / 180.0);
+    double angleDiff = angleToTarget - currentAngle;
 
-        // normalizacja kąta
-        while (angleDiff <= -M_PI_VAL)
-            angleDiff += 2 * M_PI_VAL;
-        while (angleDiff > M_PI_VAL)
-            angleDiff -= 2 * M_PI_VAL;
+    // normalizacja kąta
+    while (angleDiff <= -M_PI_VAL)
+        angleDiff += 2 * M_PI_VAL;
+    while (angleDiff > M_PI_VAL)
+        angleDiff -= 2 * M_PI_VAL;
 
+    inputs[k++] = (Real)(angleDiff / M_PI_VAL);
+    inputs[k++] = Real(0); // bias
+}
 
-        inputs.push_back(angleDiff / M_PI_VAL);
-        inputs.push_back(0.0); // bias
+// wynik sieci decyduje o obrocie i włączeniu silnika
+inline void applyControls(Population &pop, int i, const Real *outputs)
+{
+    if (!pop.isActive(i))
+        return;
+
+    bool rotLeft = outputs[0] > 0.0;
+    bool rotRight = outputs[1] > 0.0;
+    bool thrust = outputs[2] > 0.0;
+
+    // sterowanie
+    const ExperimentConfig &cfg = experiment();
+    pop.thrusting[i] = thrust;
+    if (rotLeft)
+        pop.rotation[i] = wrapDegrees(pop.rotation[i] - cfg.rotationSpeed);
+    if (rotRight)
+        pop.rotation[i] = wrapDegrees(pop.rotation[i] + cfg.rotationSpeed);
+
+    // ruch
+    if (thrust)
+    {
+        float angleRad = (pop.rotation[i] - 90.f) * 3.14159f / 180.f;
+        pop.velX[i] += std::cos(angleRad) * cfg.thrustPower;
+        pop.velY[i] += std::sin(angleRad) * cfg.thrustPower;
+    }
+}
 
-        brain->setCurrentInput(inputs);
-        brain->feedForward();
-        std::vector<double> outputs = brain->getOutputs();
+// kierunki laserów względem dzioba, liczone raz przy ustawieniu konfiguracji
+inline const LaserRig &laserRig()
+{
+    return experimentLasers();
+}
 
-        bool rotLeft = outputs[0] > 0.0;
-        bool rotRight = outputs[1] > 0.0;
-        bool thrust = outputs[2] > 0.0;
+// symuluje działanie czujników odległości. wypuszcza promienie w różnych kierunkach, sprawdza kolizje z przeszkodami i zapisuje odległość do najbliższej ściany.
+// Wszystkie promienie rakiety liczone są naraz jądrem z Sensor.h (SIMD lub przez siatkę przeszkód na dużych torach)
+inline void sense(Population &pop, int i, const World &world)
+{
+    if (!pop.isActive(i))
+        return;
+
+    float baseRad = (pop.rotation[i] - 90.f) * 3.14159f / 180.f;
+    const float maxLaserDist = experiment().maxLaserDist;
+    RayBatch rays;
+    prepareRays(rays, laserRig(), std::cos(baseRad), std::sin(baseRad), maxLaserDist);
+    castRaysInWorld(world, pop.posX[i], pop.posY[i], rays);
+
+    float *dists = pop.lasersOf(i);
+    std::uint8_t *hits = pop.laserHit.data() + (size_t)i * pop.laserCount;
+    for (int l = 0; l < pop.laserCount; ++l)
+    {
+        dists[l] = rays.t[l] * maxLaserDist;
+        hits[l] = rays.t[l] < 1.f;
+    }
+}
 
-        // sterowanie
-        isThrusting = thrust;
-        if (rotLeft)
-            sprite.rotate(sf::degrees(-rotationSpeed));
-        if (rotRight)
-            sprite.rotate(sf::degrees(rotationSpeed));
+// sprawdza, czy rakieta przeleciała przez niebieski punkt kontrolny. Jeśli tak, zalicza go i zmusza algorytm do celowania w kolejny punkt
+inline void checkCheckpoints(Population &pop, int i, const World &world)
+{
+    if (!pop.isActive(i))
+        return;
 
-        // ruch
-        if (thrust)
+    // sprawdzenie kolizji z punktami kontrolnymi
+    Box myBounds = rocketBounds(pop, i);
+    for (int c = 0; c < world.checkpointCount(); ++c)
+    {
+        std::uint32_t bit = 1u << c;
+        if (pop.visitedCheckpoints[i] & bit)
+            continue;
+        if (boxesIntersect(myBounds, world.checkpoints[c]))
         {
-            float angleRad = (sprite.getRotation().asDegrees() - 90.f) * 3.14159f / 180.f;
-            velocity.x += std::cos(angleRad) * thrustPower;
-            velocity.y += std::sin(angleRad) * thrustPower;
-
-            float offsetDist = 32.0f;
-            float fireX = sprite.getPosition().x - std::cos(angleRad) * offsetDist;
-            float fireY = sprite.getPosition().y - std::sin(angleRad) * offsetDist;
-            fireSprite.setPosition({fireX, fireY});
-            fireSprite.setRotation(sprite.getRotation());
+            pop.visitedCheckpoints[i] |= bit;
+            // reset dystansu, aby zmusić rakietę do lotu do nowego celu
+            pop.bestDistanceToTarget[i] = 999999.f;
         }
     }
+}
 
-    // symuluje działanie czujników odległości. wypuszcza promienie w różnych kierunkach, sprawdza kolizje z przeszkodami i zapisuje odległość do najbliższej ściany.
-    void sense(const std::vector<sf::RectangleShape> &obstacles)
-    {
-        if (dead || completed)
-            return;
-
-        sf::Vector2f origin = sprite.getPosition();
-        float baseAngle = sprite.getRotation().asDegrees() - 90.f;
-
-        // symulacja czujników odległości
-        for (size_t i = 0; i < laserAngles.size(); ++i)
-        {
-            float rad = (baseAngle + laserAngles[i]) * 3.14159f / 180.f;
-            sf::Vector2f rayEnd;
-            rayEnd.x = origin.x + std::cos(rad) * maxLaserDist;
-            rayEnd.y = origin.y + std::sin(rad) * maxLaserDist;
-
-            float closestDist = maxLaserDist;
-            sf::Vector2f closestPoint = rayEnd;
-            bool hitSomething = false;
+// sprawdza kolizje fizyczne. Jeśli rakieta uderzy w ścianę to ginie. Jeśli dotknie zielonego celu końcowego – wygrywa (oznaczana jako completed)
+inline void checkCollision(Population &pop, int i, const World &world)
+{
+    if (!pop.isActive(i))
+        return;
 
-            // sprawdzenie kolizji z przeszkodami
-            for (const auto &p : obstacles)
-            {
-                sf::FloatRect b = p.getGlobalBounds();
-                std::vector<std::pair<sf::Vector2f, sf::Vector2f>> walls = {
-                    {{b.position.x, b.position.y}, {b.position.x + b.size.x, b.position.y}},
-                    {{b.position.x + b.size.x, b.position.y}, {b.position.x + b.size.x, b.position.y + b.size.y}},
-                    {{b.position.x + b.size.x, b.position.y + b.size.y}, {b.position.x, b.position.y + b.size.y}},
-                    {{b.position.x, b.position.y + b.size.y}, {b.position.x, b.position.y}}};
-
-                sf::Vector2f hitPoint;
-                // sprawdzenie kolizji z ścianami
-                for (auto &wall : walls)
-                {
-                    if (getLineIntersection(origin, rayEnd, wall.first, wall.second, hitPoint))
-                    {
-                        float dist = std::sqrt(std::pow(hitPoint.x - origin.x, 2) + std::pow(hitPoint.y - origin.y, 2));
-                        if (dist < closestDist)
-                        {
-                            closestDist = dist;
-                            closestPoint = hitPoint;
-                            hitSomething = true;
-                        }
-                    }
-                }
-            }
-            lasers[i] = {closestPoint, closestDist, hitSomething};
-        }
+    Box myBounds = rocketBounds(pop, i);
+    if (world.useGrid())
+    {
+        // tylko przeszkody z komórek, na które zachodzi rakieta
+        world.grid.forEachCandidate(myBounds, [&](int p)
+                                    {
+            if (boxesIntersect(myBounds, world.przeszkody[p]))
+                pop.dead[i] = 1; });
     }
-
-    // sprawdza, czy rakieta przeleciała przez niebieski punkt kontrolny. Jeśli tak, zalicza go i zmusza algorytm do celowania w kolejny punkt
-    void checkCheckpoints(const std::vector<sf::CircleShape> &checkpoints)
+    else
     {
-        if (dead || completed)
-            return;
-
-        if (visitedCheckpoints.size() != checkpoints.size())
+        for (const Box &p : world.przeszkody)
         {
-            visitedCheckpoints.resize(checkpoints.size(), false);
-        }
-
-        // sprawdzenie kolizji z punktami kontrolnymi
-        sf::FloatRect myBounds = sprite.getGlobalBounds();
-        for (size_t i = 0; i < checkpoints.size(); ++i)
-        {
-            if (visitedCheckpoints[i])
-                continue;
-            if (myBounds.findIntersection(checkpoints[i].getGlobalBounds()))
+            if (boxesIntersect(myBounds, p))
             {
-                visitedCheckpoints[i] = true;
-                // reset dystansu, aby zmusić rakietę do lotu do nowego celu
-                bestDistanceToTarget = 999999.f;
+                pop.dead[i] = 1;
             }
         }
     }
-
-    // sprawdza kolizje fizyczne. Jeśli rakieta uderzy w ścianę to ginie. Jeśli dotknie zielonego celu końcowego – wygrywa (oznaczana jako completed)
-    void checkCollision(const std::vector<sf::RectangleShape> &obstacles, sf::Vector2f targetPos)
+    // kolizja z granicami ekranu
+    float x = pop.posX[i];
+    float y = pop.posY[i];
+    if (x < 0 || x > world.width || y < 0 || y > world.height)
     {
-        if (dead || completed)
-            return;
-
-        for (const auto &p : obstacles)
-        {
-            if (sprite.getGlobalBounds().findIntersection(p.getGlobalBounds()))
-            {
-                dead = true;
-            }
-        }
-        // kolizja z granicami ekranu
-        if (sprite.getPosition().x < 0 || sprite.getPosition().x > 1000 ||
-            sprite.getPosition().y < 0 || sprite.getPosition().y > 1000)
-        {
-            dead = true;
-        }
-
-        float dist = std::sqrt(std::pow(sprite.getPosition().x - targetPos.x, 2) +
-                               std::pow(sprite.getPosition().y - targetPos.y, 2));
-        if (dist < 50.0f)
-        {
-            bool allVisited = true;
-            for (auto v : visitedCheckpoints)
-                if (!v)
-                    allVisited = false;
-
-            if (allVisited)
-            {
-                completed = true;
-                dead = true;
-            }
-        }
+        pop.dead[i] = 1;
     }
 
-    // Funkcja oceny (Fitness Function). Oblicza wynik rakiety na koniec życia. Punktuje (w kolejności ważności): zdobyte checkpointy, bliskość do aktualnego celu, ukończenie trasy i szybkość przelotu. Decyduje o tym, kto przekaże geny dalej.
-    void calcFitness(const std::vector<sf::CircleShape> &checkpoints, sf::Vector2f finalTarget, sf::Vector2f startPos, int maxLifetime)
+    float dx = x - world.cel.x;
+    float dy = y - world.cel.y;
+    float dist = std::sqrt(dx * dx + dy * dy);
+    if (dist < world.celRadius)
     {
-        fitness = 0.0;
-
-        // 1. Checkpointy (Baza sukcesu) - 10,000 pkt za każdy
-        int checkpointCount = 0;
-        for (bool visited : visitedCheckpoints)
+        if (pop.visitedCheckpoints[i] == allCheckpointsMask(world.checkpointCount()))
         {
-            if (visited)
-                checkpointCount++;
+            pop.completed[i] = 1;
+            pop.dead[i] = 1;
         }
-        fitness += checkpointCount * 10000.0;
+    }
+}
 
-        // 2. dystans do aktualnego celu (max 2000 pkt)
-        // dzięki temu, że max za dystans (2000) < bonus za checkpoint (10000),
-        // rakieta, która zdobyła checkpoint zawsze wygrywa z tą, która jest tylko blisko.
-        if (bestDistanceToTarget < 99999.f)
-        {
-            double distReward = std::max(0.0, 2000.0 - (bestDistanceToTarget * 2.0));
-            fitness += distReward;
-        }
+// Funkcja oceny (Fitness Function). Oblicza wynik rakiety na koniec życia. Punktuje (w kolejności ważności): zdobyte checkpointy, bliskość do aktualnego celu, ukończenie trasy i szybkość przelotu. Decyduje o tym, kto przekaże geny dalej.
+// start - pozycja, z której rakieta wystartowała w tym locie (przy losowych startach Curriculum różna od world.startPos)
+inline void calcFitness(Population &pop, int i, const World &world, sf::Vector2f start, int maxLifetime)
+{
+    double fitness = 0.0;
 
-        // 3. bonus za ukończenie i szybkość
-        if (completed)
-        {
-            fitness += 20000.0;
-            // im szybciej, tym więcej punktów
-            fitness += ((double)maxLifetime / (double)(timeAlive + 1)) * 5000.0;
-        }
+    // 1. Checkpointy (Baza sukcesu) - 10,000 pkt za każdy
+    fitness += pop.checkpointsVisited(i) * 10000.0;
 
-        // 4. mikro-nagroda za ruch (żeby nie kręciły się w miejscu)
-        float totalMovement = std::sqrt(
-            std::pow(sprite.getPosition().x - startPos.x, 2) +
-            std::pow(sprite.getPosition().y - startPos.y, 2));
-        fitness += totalMovement * 0.1;
+    // 2. dystans do aktualnego celu (max 2000 pkt)
+    // dzięki temu, że max za dystans (2000) < bonus za checkpoint (10000),
+    // rakieta, która zdobyła checkpoint zawsze wygrywa z tą, która jest tylko blisko.
+    if (pop.bestDistanceToTarget[i] < 99999.f)
+    {
+        double distReward = std::max(0.0, 2000.0 - (pop.bestDistanceToTarget[i] * 2.0));
+        fitness += distReward;
     }
 
-    // rysuje rakietę na ekranie. Jeśli silnik jest włączony, dorysowuje ogień. Najlepsza rakieta w populacji jest wyróżniona kolorem zielonym
-    void draw(sf::RenderWindow &win, bool best)
+    // 3. bonus za ukończenie i szybkość
+    if (pop.completed[i])
     {
-        if (dead && !best)
-            return;
-        if (isThrusting && !dead)
-            win.draw(fireSprite);
-        if (best)
-            sprite.setColor(sf::Color::Green);
-        else
-            sprite.setColor(sf::Color(255, 255, 255, 100));
-        win.draw(sprite);
+        fitness += 20000.0;
+        // im szybciej, tym więcej punktów
+        fitness += ((double)maxLifetime / (double)(pop.timeAlive[i] + 1)) * 5000.0;
     }
-};
+
+    // 4. mikro-nagroda za ruch (żeby nie kręciły się w miejscu)
+    float mx = pop.posX[i] - start.x;
+    float my = pop.posY[i] - start.y;
+    float totalMovement = std::sqrt(mx * mx + my * my);
+    fitness += totalMovement * 0.1;
+
+    pop.fitness[i] = fitness;
+}
 
 #endif // ROCKET_H
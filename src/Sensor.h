@@ -0,0 +1,224 @@
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SENSOR_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SENSOR_SSE 1
+#endif
+
+#include "World.h"
+#include "SpatialGrid.h"
+
+// Jądro czujników odległości (raycast promień - prostokąt metodą "slab").
+// Promienie jednej rakiety liczone są równolegle: każdy promień to osobny pas rejestru SIMD
+// (8 pasów AVX lub 4 pasy SSE), a przeszkody są rozgłaszane po kolei z tablic ObstacleArrays.
+// Bez SIMD działa ta sama pętla skalarna.
+
+// maksymalna liczba laserów na rakietę (wielokrotność szerokości AVX)
+const int MAX_LASERS = 16;
+
+// Kierunki laserów względem dzioba rakiety - cos/sin liczone raz, a nie w każdym kroku
+struct LaserRig
+{
+    int count = 0;
+    alignas(32) float cosA[MAX_LASERS] = {};
+    alignas(32) float sinA[MAX_LASERS] = {};
+
+    explicit LaserRig(const std::vector<float> &anglesDeg)
+    {
+        assert((int)anglesDeg.size() <= MAX_LASERS);
+        count = (int)anglesDeg.size();
+        for (int l = 0; l < count; ++l)
+        {
+            float rad = anglesDeg[l] * 3.14159f / 180.f;
+            cosA[l] = std::cos(rad);
+            sinA[l] = std::sin(rad);
+        }
+    }
+};
+
+// Promienie jednej rakiety: odwrotności wektorów kierunku o długości lasera (parametr t w [0, 1])
+struct RayBatch
+{
+    int count = 0;
+    alignas(32) float invX[MAX_LASERS];
+    alignas(32) float invY[MAX_LASERS];
+    alignas(32) float t[MAX_LASERS]; // wynik: ułamek długości lasera do najbliższej ściany (1 = brak trafienia)
+};
+
+// odwrotność składowej kierunku; składowa bliska zera jest zastępowana małą liczbą z zachowaniem znaku,
+// żeby w metodzie slab nie powstało 0 * inf = NaN
+inline float safeInverse(float d)
+{
+    const float eps = 1e-8f;
+    if (std::abs(d) < eps)
+        d = d < 0.f ? -eps : eps;
+    return 1.f / d;
+}
+
+// Ustawia promienie rakiety o kierunku dzioba (cos, sin) - kierunek każdego lasera to obrót o kąt lasera
+inline void prepareRays(RayBatch &rays, const LaserRig &rig, float baseCos, float baseSin, float maxDist)
+{
+    rays.count = rig.count;
+    for (int l = 0; l < MAX_LASERS; ++l)
+    {
+        float dx = (baseCos * rig.cosA[l] - baseSin * rig.sinA[l]) * maxDist;
+        float dy = (baseSin * rig.cosA[l] + baseCos * rig.sinA[l]) * maxDist;
+        rays.invX[l] = safeInverse(dx);
+        rays.invY[l] = safeInverse(dy);
+    }
+}
+
+// Trafienie promienia w prostokąt b metodą slab; zwraca t w [0, 1] lub 2, gdy promień go nie trafia
+inline float slabHit(const ObstacleArrays &obs, int b, float ox, float oy, float invX, float invY)
+{
+    float tx1 = (obs.minX[b] - ox) * invX;
+    float tx2 = (obs.maxX[b] - ox) * invX;
+    float ty1 = (obs.minY[b] - oy) * invY;
+    float ty2 = (obs.maxY[b] - oy) * invY;
+    float tNear = std::max(std::min(tx1, tx2), std::min(ty1, ty2));
+    float tFar = std::min(std::max(tx1, tx2), std::max(ty1, ty2));
+    // promień startujący wewnątrz prostokąta trafia w ścianę przy wyjściu
+    float t = tNear >= 0.f ? tNear : tFar;
+    return (tNear <= tFar && tFar >= 0.f) ? t : 2.f;
+}
+
+// wersja skalarna dla promieni [begin, end)
+inline void castRaysScalar(const ObstacleArrays &obs, float ox, float oy, RayBatch &rays, int begin, int end)
+{
+    for (int r = begin; r < end; ++r)
+    {
+        float best = 1.f;
+        for (int b = 0; b < obs.size(); ++b)
+            best = std::min(best, slabHit(obs, b, ox, oy, rays.invX[r], rays.invY[r]));
+        rays.t[r] = best;
+    }
+}
+
+// Liczy najbliższe trafienie każdego promienia z punktu (ox, oy)
+inline void castRays(const ObstacleArrays &obs, float ox, float oy, RayBatch &rays)
+{
+#if defined(SENSOR_AVX)
+    const int lanes = 8;
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 vox = _mm256_set1_ps(ox);
+    const __m256 voy = _mm256_set1_ps(oy);
+    for (int r = 0; r < rays.count; r += lanes)
+    {
+        const __m256 invX = _mm256_load_ps(rays.invX + r);
+        const __m256 invY = _mm256_load_ps(rays.invY + r);
+        __m256 best = _mm256_set1_ps(1.f);
+        for (int b = 0; b < obs.size(); ++b)
+        {
+            __m256 tx1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(obs.minX[b]), vox), invX);
+            __m256 tx2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(obs.maxX[b]), vox), invX);
+            __m256 ty1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(obs.minY[b]), voy), invY);
+            __m256 ty2 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(obs.maxY[b]), voy), invY);
+            __m256 tNear = _mm256_max_ps(_mm256_min_ps(tx1, tx2), _mm256_min_ps(ty1, ty2));
+            __m256 tFar = _mm256_min_ps(_mm256_max_ps(tx1, tx2), _mm256_max_ps(ty1, ty2));
+            __m256 t = _mm256_blendv_ps(tFar, tNear, _mm256_cmp_ps(tNear, zero, _CMP_GE_OQ));
+            __m256 valid = _mm256_and_ps(_mm256_cmp_ps(tNear, tFar, _CMP_LE_OQ), _mm256_cmp_ps(tFar, zero, _CMP_GE_OQ));
+            best = _mm256_min_ps(best, _mm256_blendv_ps(best, t, valid));
+        }
+        _mm256_store_ps(rays.t + r, best);
+    }
+#elif defined(SENSOR_SSE)
+    const int lanes = 4;
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 vox = _mm_set1_ps(ox);
+    const __m128 voy = _mm_set1_ps(oy);
+    // wybór bez SSE4.1: mask ? a : b
+    auto select = [](__m128 mask, __m128 a, __m128 b)
+    { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+    for (int r = 0; r < rays.count; r += lanes)
+    {
+        const __m128 invX = _mm_load_ps(rays.invX + r);
+        const __m128 invY = _mm_load_ps(rays.invY + r);
+        __m128 best = _mm_set1_ps(1.f);
+        for (int b = 0; b < obs.size(); ++b)
+        {
+            __m128 tx1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(obs.minX[b]), vox), invX);
+            __m128 tx2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(obs.maxX[b]), vox), invX);
+            __m128 ty1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(obs.minY[b]), voy), invY);
+            __m128 ty2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(obs.maxY[b]), voy), invY);
+            __m128 tNear = _mm_max_ps(_mm_min_ps(tx1, tx2), _mm_min_ps(ty1, ty2));
+            __m128 tFar = _mm_min_ps(_mm_max_ps(tx1, tx2), _mm_max_ps(ty1, ty2));
+            __m128 t = select(_mm_cmpge_ps(tNear, zero), tNear, tFar);
+            __m128 valid = _mm_and_ps(_mm_cmple_ps(tNear, tFar), _mm_cmpge_ps(tFar, zero));
+            best = _mm_min_ps(best, select(valid, t, best));
+        }
+        _mm_store_ps(rays.t + r, best);
+    }
+#else
+    castRaysScalar(obs, ox, oy, rays, 0, rays.count);
+#endif
+}
+
+// Wersja z indeksem przestrzennym: każdy promień przechodzi przez komórki siatki algorytmem DDA
+// (Amanatides-Woo) i sprawdza tylko przeszkody z odwiedzonych komórek. Przejście kończy się,
+// gdy najbliższe trafienie leży przed wyjściem z bieżącej komórki albo promień osiągnie zasięg lasera.
+// Punkt startowy musi leżeć wewnątrz siatki (grid.contains)
+inline void castRaysGrid(const ObstacleGrid &grid, const ObstacleArrays &obs, float ox, float oy, RayBatch &rays)
+{
+    const int startX = grid.cellX(ox);
+    const int startY = grid.cellY(oy);
+    for (int r = 0; r < rays.count; ++r)
+    {
+        const float invX = rays.invX[r];
+        const float invY = rays.invY[r];
+        int ix = startX, iy = startY;
+        const int stepX = invX >= 0.f ? 1 : -1;
+        const int stepY = invY >= 0.f ? 1 : -1;
+        float tMaxX = (grid.originX + (ix + (stepX > 0)) * grid.cellSize - ox) * invX;
+        float tMaxY = (grid.originY + (iy + (stepY > 0)) * grid.cellSize - oy) * invY;
+        const float tDeltaX = grid.cellSize * std::abs(invX);
+        const float tDeltaY = grid.cellSize * std::abs(invY);
+
+        float best = 1.f;
+        while (true)
+        {
+            const int c = iy * grid.cols + ix;
+            for (int k = grid.start[c]; k < grid.start[c + 1]; ++k)
+                best = std::min(best, slabHit(obs, grid.items[k], ox, oy, invX, invY));
+
+            const float tExit = std::min(tMaxX, tMaxY);
+            if (best <= tExit || tExit >= 1.f)
+                break;
+            if (tMaxX < tMaxY)
+            {
+                ix += stepX;
+                if (ix < 0 || ix >= grid.cols)
+                    break;
+                tMaxX += tDeltaX;
+            }
+            else
+            {
+                iy += stepY;
+                if (iy < 0 || iy >= grid.rows)
+                    break;
+                tMaxY += tDeltaY;
+            }
+        }
+        rays.t[r] = best;
+    }
+}
+
+// Wybór wariantu: dla małych torów liniowe jądro SIMD jest szybsze niż przechodzenie siatki
+inline void castRaysInWorld(const World &world, float ox, float oy, RayBatch &rays)
+{
+    if (world.useGrid() && world.grid.contains(ox, oy))
+        castRaysGrid(world.grid, world.przeszkodySoA, ox, oy, rays);
+    else
+        castRays(world.przeszkodySoA, ox, oy, rays);
+}
+
+#endif // SENSOR_H
@@ -0,0 +1,299 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <vector>
+#include <limits>
+#include <iostream>
+#include <algorithm>
+#include <mutex>
+#include <cstdint>
+
+#include "World.h"
+#include "Population.h"
+#include "Rocket.h"
+#include "GeneticAlgorithm.h"
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include "Metrics.h"
+
+// Tworzy początkową populację z losowymi wagami
+inline void createPopulation(Population &pop, const World &world)
+{
+    pop.resize(experiment().populationSize, experiment().laserCount(), experimentTopology());
+    pop.resetAll(world.startPos);
+}
+
+// Wynik jednego kroku symulacji (dla porcji albo całej populacji)
+struct StepResult
+{
+    int active = 0;          // rakiety aktywne na początku kroku
+    int remaining = 0;       // rakiety aktywne po kroku
+    int stuck = 0;           // aktywne po kroku, które w ostatnim oknie 100 kroków nie ruszyły się z miejsca
+    bool progressed = false; // któraś rakieta poprawiła bestDistanceToTarget albo zdobyła checkpoint
+
+    void add(const StepResult &r)
+    {
+        active += r.active;
+        remaining += r.remaining;
+        stuck += r.stuck;
+        progressed = progressed || r.progressed;
+    }
+};
+
+// Krok symulacji dla aktywnych rakiet porcji c.
+// Krok jest podzielony na fazy, każda jako osobna pętla po porcji (i osobny pomiar w Profiler.h):
+// czujniki, checkpointy, wejścia sieci do partii + wsadowe sieci + sterowanie, fizyka i kolizje.
+// Rakieta czyta tylko wspólny tor i pisze tylko swój stan, więc kolejność faz dla każdej rakiety jest ta sama co w jednej pętli. Porcja używa wierszy partii
+// od chunkBegin[c], więc porcje nie współdzielą danych, a wynik rakiety nie zależy od kolejności
+// w zbiorze aktywnych, podziału na porcje ani liczby wątków. Na końcu rakiety, które zginęły
+// lub ukończyły lot, są usuwane ze zbioru aktywnych (zamiana z ostatnią)
+inline StepResult stepChunk(Population &pop, const World &world, int c)
+{
+    StepResult result;
+    const int begin = pop.chunkBegin[c];
+    int *ids = pop.activeIds.data() + begin;
+    int count = pop.chunkActive[c];
+    if (count == 0)
+        return result;
+
+    {
+        PROFILE_SCOPE(Phase::Sense, count);
+        for (int r = 0; r < count; ++r)
+        {
+            int i = ids[r];
+            pop.timeAlive[i]++;
+            sense(pop, i, world);
+        }
+    }
+
+    {
+        PROFILE_SCOPE(Phase::Checkpoints, count);
+        for (int r = 0; r < count; ++r)
+        {
+            int i = ids[r];
+            std::uint32_t visitedBefore = pop.visitedCheckpoints[i];
+            checkCheckpoints(pop, i, world);
+            result.progressed = result.progressed || pop.visitedCheckpoints[i] != visitedBefore;
+        }
+    }
+
+    {
+        PROFILE_SCOPE(Phase::Think, count);
+        for (int r = 0; r < count; ++r)
+        {
+            int i = ids[r];
+            float bestBefore = pop.bestDistanceToTarget[i];
+            buildInputs(pop, i, world, pop.net.inputRow(begin + r));
+            result.progressed = result.progressed || pop.bestDistanceToTarget[i] < bestBefore;
+        }
+        pop.net.feedForwardRange(begin, begin + count, pop.genomes.data(), pop.genomeSize, pop.activeIds.data());
+        for (int r = 0; r < count; ++r)
+            applyControls(pop, ids[r], pop.net.outputRow(begin + r));
+    }
+
+    {
+        PROFILE_SCOPE(Phase::Physics, count);
+        for (int r = 0; r < count; ++r)
+            updatePhysics(pop, ids[r]);
+    }
+
+    PROFILE_SCOPE(Phase::Collision, count);
+    for (int r = 0; r < count; ++r)
+        checkCollision(pop, ids[r], world);
+
+    result.active = count;
+    for (int r = 0; r < count;)
+    {
+        if (pop.isActive(ids[r]))
+        {
+            if (pop.stuckCounter[ids[r]] > 0)
+                result.stuck++;
+            ++r;
+        }
+        else
+            ids[r] = ids[--count];
+    }
+    pop.chunkActive[c] = count;
+    result.remaining = count;
+    return result;
+}
+
+// Sumuje wyniki porcji liczonych przez różne wątki
+class StepAccumulator
+{
+public:
+    void add(const StepResult &r)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        total.add(r);
+    }
+    StepResult result() const { return total; }
+
+private:
+    std::mutex mutex;
+    StepResult total;
+};
+
+// Jeden krok symulacji dla całej populacji (wszystkich aktywnych rakiet).
+// Z pulą wątków porcje rakiet liczone są równolegle (rakieta czyta tylko wspólne przeszkody i pisze tylko swój stan)
+inline StepResult stepPopulation(Population &pop, const World &world, ThreadPool *pool = nullptr)
+{
+    StepResult total;
+    if (!pool)
+    {
+        for (int c = 0; c < pop.chunkCount(); ++c)
+            total.add(stepChunk(pop, world, c));
+        PROFILE_TICK();
+        return total;
+    }
+
+    StepAccumulator acc;
+    pool->parallelFor(0, pop.chunkCount(), 1, [&](int b, int e)
+                      {
+        StepResult part;
+        for (int c = b; c < e; ++c)
+            part.add(stepChunk(pop, world, c));
+        acc.add(part); });
+    PROFILE_TICK();
+    return acc.result();
+}
+
+// Reguły wcześniejszego końca pokolenia. Domyślnie wyłączone - pokolenie trwa, aż wszystkie rakiety
+// zginą albo minie lifetime kroków (Config.h). Pod koniec pokolenia większość rakiet zwykle już nie żyje albo wisi
+// w miejscu, więc reguły pozwalają pominąć kroki, które nie zmienią już fitnessu w istotny sposób
+struct EarlyStop
+{
+    int stallTicks = 0;    // koniec, gdy przez tyle kroków żadna rakieta nie zbliżyła się do celu ani nie zdobyła CP (0 = wyłączone)
+    bool allStuck = false; // koniec, gdy wszystkie aktywne rakiety stoją w miejscu
+
+    bool enabled() const { return stallTicks > 0 || allStuck; }
+};
+
+// Śledzi kroki bez postępu w bieżącym pokoleniu i decyduje o końcu według EarlyStop
+class EarlyStopMonitor
+{
+public:
+    void reset() { stalled = 0; }
+
+    // Wywoływane po każdym kroku; zwraca true, jeśli pokolenie należy zakończyć
+    bool update(const EarlyStop &rules, const StepResult &step)
+    {
+        stalled = step.progressed ? 0 : stalled + 1;
+        if (rules.stallTicks > 0 && stalled >= rules.stallTicks)
+            return true;
+        return rules.allStuck && step.remaining > 0 && step.stuck == step.remaining;
+    }
+
+private:
+    int stalled = 0;
+};
+
+// Liczy fitness każdej rakiety i zbiera statystyki pokolenia
+inline GenerationStats evaluateGeneration(Population &pop, const World &world)
+{
+    GenerationStats stats;
+    PROFILE_SCOPE(Phase::Fitness, pop.size);
+    for (int i = 0; i < pop.size; ++i)
+    {
+        calcFitness(pop, i, world, world.startPos, experiment().lifetime);
+        if (pop.fitness[i] > stats.maxFit)
+            stats.maxFit = pop.fitness[i];
+        stats.sumFit += pop.fitness[i];
+        if (pop.completed[i])
+            stats.completedCount++;
+
+        // Obliczenie ilości odwiedzonych checkpointów
+        stats.maxCheckpoints = std::max(stats.maxCheckpoints, pop.checkpointsVisited(i));
+    }
+    return stats;
+}
+
+// Wypisanie statystyk pokolenia (jednym zapisem na konsolę)
+inline void printGenerationStats(int generation, const GenerationStats &stats, const World &world)
+{
+    std::cout << formatGenerationStats(generation, stats, experiment().populationSize, world.checkpointCount()) << std::flush;
+}
+
+// Trening krok po kroku (dla pętli z oknem). Pokolenie kończy się, gdy wszystkie rakiety są martwe,
+// minie lifetime kroków albo zadziała reguła EarlyStop - tak samo jak w headless, więc to samo ziarno
+// daje ten sam przebieg niezależnie od tego, ile kroków przypada na klatkę
+class TrainingLoop
+{
+public:
+    // metrics - zapis statystyk w tle (nullptr = wypisywanie na konsolę w wątku symulacji)
+    TrainingLoop(Population &pop, const World &world, std::uint64_t seed, ThreadPool *pool = nullptr, EarlyStop earlyStop = {},
+                 MetricsWriter *metrics = nullptr)
+        : pop(pop), world(world), seed(seed), pool(pool), earlyStop(earlyStop), metrics(metrics) {}
+
+    // Jeden krok symulacji; zwraca true, jeśli zakończył pokolenie (populacja jest już po ewolucji)
+    bool tick()
+    {
+        StepResult step = stepPopulation(pop, world, pool);
+        timer++;
+        bool stop = stopMonitor.update(earlyStop, step);
+        if (step.active > 0 && timer <= experiment().lifetime && !stop)
+            return false;
+
+        // Obliczenie fitnessu i wypisanie statystyk
+        GenerationStats stats = evaluateGeneration(pop, world);
+        stats.steps = timer;
+        if (metrics)
+        {
+            collector.collect(generationMetrics, generation, stats, pop, pop, world.checkpointCount());
+            metrics->push(generationMetrics);
+        }
+        else
+            printGenerationStats(generation, stats, world);
+
+        // Wyznaczenie nowej populacji
+        evolve(pop, world.startPos, seed, generation, pool);
+        PROFILE_GENERATION(generation);
+        generation++;
+        timer = 0;
+        stopMonitor.reset();
+        return true;
+    }
+
+    int getGeneration() const { return generation; }
+    int getTimer() const { return timer; }
+
+private:
+    Population &pop;
+    const World &world;
+    std::uint64_t seed;
+    ThreadPool *pool;
+    EarlyStop earlyStop;
+    EarlyStopMonitor stopMonitor;
+    MetricsWriter *metrics;
+    MetricsCollector collector;
+    GenerationMetrics generationMetrics;
+    int generation = 1;
+    int timer = 0;
+};
+
+// Wybiera rakietę do wyróżnienia: żywą z największą liczbą CP, najbliżej aktualnego celu
+inline int findBestRocket(const Population &pop)
+{
+    int bestIdx = 0;
+    double bestScore = -1.0;
+
+    // Prostym sposobem wizualizacji jest pokazanie tej, która ma najwięcej CP
+    // i jest najbliżej celu (liczone na bieżąco dla wizualizacji)
+    for (int i = 0; i < pop.size; ++i)
+    {
+        // Jeśli rakieta jest martwa, przechodzimy do następnej
+        if (pop.dead[i])
+            continue;
+
+        // Obliczenie wyniku
+        double score = pop.checkpointsVisited(i) * 10000.0 - pop.bestDistanceToTarget[i];
+        if (score > bestScore)
+        {
+            bestScore = score;
+            bestIdx = i;
+        }
+    }
+    return bestIdx;
+}
+
+#endif // SIMULATION_H
@@ -0,0 +1,101 @@
+#ifndef SIMULATION_THREAD_H
+#define SIMULATION_THREAD_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "World.h"
+#include "Population.h"
+#include "Simulation.h"
+#include "FixedStep.h"
+#include "RenderFrame.h"
+#include "TripleBuffer.h"
+#include "ThreadPool.h"
+#include "Metrics.h"
+
+// najkrótszy odstęp między kolejnymi obrazami do narysowania (ok. 120 na sekundę) - kopiowanie stanu
+// częściej niż odświeżanie ekranu byłoby zbędną pracą wątku symulacji
+const double FRAME_PUBLISH_INTERVAL = 1.0 / 120.0;
+
+// Symulacja we własnym wątku. Wątek wykonuje kroki TrainingLoop w tempie wyznaczonym przez FixedStep
+// i publikuje obrazy stanu (RenderFrame) przez potrójny bufor bez blokad. Wątek okna tylko przejmuje
+// najnowszy obraz i go rysuje - wolne rysowanie nie spowalnia symulacji, a wynik nadal zależy tylko od ziarna.
+// Populacja i świat należą do wątku symulacji aż do zniszczenia obiektu.
+class SimulationThread
+{
+public:
+    SimulationThread(Population &pop, const World &world, std::uint64_t seed, ThreadPool *pool = nullptr, MetricsWriter *metrics = nullptr)
+        : pop(pop), training(pop, world, seed, pool, EarlyStop{}, metrics)
+    {
+        // pierwszy obraz jest gotowy od razu, zanim wątek wykona jakikolwiek krok
+        captureFrame(pop, frames.writeBuffer(), training.getGeneration(), training.getTimer());
+        frames.publish();
+        worker = std::thread([this]
+                             { run(); });
+    }
+
+    ~SimulationThread()
+    {
+        running = false;
+        worker.join();
+    }
+
+    SimulationThread(const SimulationThread &) = delete;
+    SimulationThread &operator=(const SimulationThread &) = delete;
+
+    void setSpeed(SimSpeed s) { speed = s; }
+    SimSpeed getSpeed() const { return speed; }
+
+    // Przejmuje najnowszy obraz (jeśli jest nowy) i zwraca obraz do narysowania - tylko z wątku okna
+    const RenderFrame &latestFrame()
+    {
+        frames.acquire();
+        return frames.readBuffer();
+    }
+
+private:
+    void run()
+    {
+        using clock = std::chrono::steady_clock;
+        auto last = clock::now();
+        auto lastPublish = last;
+        bool unpublished = false;
+        while (running)
+        {
+            auto now = clock::now();
+            double elapsed = std::chrono::duration<double>(now - last).count();
+            last = now;
+
+            SimSpeed requested = speed;
+            if (requested != fixedStep.getSpeed())
+                fixedStep.setSpeed(requested);
+
+            int steps = fixedStep.run(elapsed, [&]
+                                      { training.tick(); });
+            unpublished = unpublished || steps > 0;
+
+            now = clock::now();
+            if (unpublished && std::chrono::duration<double>(now - lastPublish).count() >= FRAME_PUBLISH_INTERVAL)
+            {
+                captureFrame(pop, frames.writeBuffer(), training.getGeneration(), training.getTimer());
+                frames.publish();
+                lastPublish = now;
+                unpublished = false;
+            }
+            if (steps == 0)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    Population &pop;
+    TrainingLoop training;
+    FixedStep fixedStep;
+    TripleBuffer<RenderFrame> frames;
+    std::atomic<SimSpeed> speed{SimSpeed::X1};
+    std::atomic<bool> running{true};
+    std::thread worker; // ostatnie pole - startuje po zainicjalizowaniu pozostałych
+};
+
+#endif // SIMULATION_THREAD_H
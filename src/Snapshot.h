@@ -0,0 +1,277 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Population.h"
+#include "GeneticAlgorithm.h"
+#include "Curriculum.h"
+#include "Random.h"
+#include "FileIO.h"
+#include "Config.h"
+#include "siec/FlatNetwork.h"
+
+// Zapis i wznawianie treningu.
+// Migawka powstaje po ocenie pokolenia: genotypy tego pokolenia, ich fitness, numer pokolenia,
+// ziarno główne, ustawienia oceny i pełna konfiguracja eksperymentu (Config.h). Wszystkie liczby losowe ewolucji i startów wynikają z (ziarno, pokolenie),
+// więc wznowiony trening wykonuje evolve() dla zapisanego pokolenia i dalej przebiega identycznie
+// jak trening bez przerwy.
+//
+// Plik (.snap) - little-endian:
+//     SnapshotHeader
+//     int32   topology[layerCount]
+//     double  genomes[populationSize * genomeSize]    (zawsze double, niezależnie od ROCKETS_FLOAT32)
+//     double  fitness[populationSize]
+//     char    config[configSize]                      (formatExperiment(), bez zera na końcu)
+
+const char SNAPSHOT_MAGIC[4] = {'R', 'S', 'N', 'P'};
+const std::uint32_t SNAPSHOT_VERSION = 2;
+
+struct SnapshotHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t masterSeed;
+    std::int32_t generation;
+    std::int32_t populationSize;
+    std::int32_t genomeSize;
+    std::int32_t layerCount;
+    std::int32_t laserCount;
+    std::int32_t lifetime;
+    double mutationRate;
+    double mutationStrength;
+    // ustawienia oceny (Curriculum)
+    std::int32_t scenarioMaps;
+    std::int32_t startsPerMap;
+    float startJitter;
+    std::int32_t aggregate;
+    double percentile;
+    std::uint32_t configSize;
+    std::uint32_t reserved;
+};
+static_assert(sizeof(SnapshotHeader) == 88, "SnapshotHeader musi mieć stały rozmiar");
+
+// Wczytana migawka
+struct Snapshot
+{
+    SnapshotHeader header;
+    std::vector<int> topology;
+    std::vector<double> genomes;
+    std::vector<double> fitness;
+    std::string config; // tekst konfiguracji, z którą powstała migawka
+};
+
+// Serializuje stan pokolenia do bufora (bufor jest używany ponownie, bez alokacji po pierwszym razie)
+inline void serializeSnapshot(std::vector<char> &out, const Population &pop, int generation, std::uint64_t seed, const Curriculum &cur)
+{
+    SnapshotHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, SNAPSHOT_MAGIC, 4);
+    h.version = SNAPSHOT_VERSION;
+    h.masterSeed = seed;
+    h.generation = generation;
+    h.populationSize = pop.size;
+    h.genomeSize = pop.genomeSize;
+    h.layerCount = (std::int32_t)pop.topology.size();
+    h.laserCount = pop.laserCount;
+    h.lifetime = experiment().lifetime;
+    h.mutationRate = experiment().mutationRate / 100.0;
+    h.mutationStrength = experiment().mutationStrength;
+    h.scenarioMaps = (std::int32_t)cur.maps.size();
+    h.startsPerMap = cur.startsPerMap;
+    h.startJitter = cur.startJitter;
+    h.aggregate = (std::int32_t)cur.aggregate;
+    h.percentile = cur.percentile;
+    const std::string config = formatExperiment(experiment());
+    h.configSize = (std::uint32_t)config.size();
+
+    const size_t genomeBytes = pop.genomes.size() * sizeof(double);
+    out.resize(sizeof(h) + pop.topology.size() * sizeof(std::int32_t) + genomeBytes + pop.size * sizeof(double) + config.size());
+    char *p = out.data();
+    std::memcpy(p, &h, sizeof(h));
+    p += sizeof(h);
+    for (int layer : pop.topology)
+    {
+        std::int32_t v = layer;
+        std::memcpy(p, &v, sizeof(v));
+        p += sizeof(v);
+    }
+    for (Real gene : pop.genomes)
+    {
+        double v = gene;
+        std::memcpy(p, &v, sizeof(v));
+        p += sizeof(v);
+    }
+    std::memcpy(p, pop.fitness.data(), pop.size * sizeof(double));
+    p += pop.size * sizeof(double);
+    std::memcpy(p, config.data(), config.size());
+}
+
+// Wczytuje migawkę z pliku
+inline bool loadSnapshot(const std::string &path, Snapshot &out)
+{
+    std::vector<char> data;
+    if (!readFile(path, data))
+    {
+        std::cerr << "Nie można otworzyć migawki: " << path << std::endl;
+        return false;
+    }
+
+    SnapshotHeader h;
+    if (data.size() < sizeof(h))
+    {
+        std::cerr << path << ": plik za krótki" << std::endl;
+        return false;
+    }
+    std::memcpy(&h, data.data(), sizeof(h));
+    if (std::memcmp(h.magic, SNAPSHOT_MAGIC, 4) != 0 || h.version != SNAPSHOT_VERSION)
+    {
+        std::cerr << path << ": nieznany format migawki" << std::endl;
+        return false;
+    }
+    // liczniki z nagłówka ogranicza rozmiar pliku, zanim zostaną przemnożone (tak jak w parseMapBinary)
+    const size_t payload = data.size() - sizeof(h);
+    const size_t maxDoubles = payload / sizeof(double);
+    bool sizesOk = h.populationSize > 0 && h.genomeSize > 0 && h.layerCount >= 2 &&
+                   (size_t)h.layerCount <= payload / sizeof(std::int32_t) && h.configSize <= payload &&
+                   (size_t)h.populationSize <= maxDoubles && (size_t)h.genomeSize <= maxDoubles / h.populationSize;
+    const size_t genomeCount = sizesOk ? (size_t)h.populationSize * h.genomeSize : 0;
+    if (sizesOk)
+    {
+        const std::uint64_t expected = sizeof(h) + (std::uint64_t)h.layerCount * sizeof(std::int32_t) +
+                                       ((std::uint64_t)genomeCount + h.populationSize) * sizeof(double) + h.configSize;
+        sizesOk = data.size() == expected;
+    }
+    if (!sizesOk)
+    {
+        std::cerr << path << ": uszkodzona migawka" << std::endl;
+        return false;
+    }
+
+    const char *p = data.data() + sizeof(h);
+    std::vector<int> topology(h.layerCount);
+    for (int l = 0; l < h.layerCount; ++l)
+    {
+        std::int32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        p += sizeof(v);
+        topology[l] = v;
+    }
+    if (!FlatNetwork::validTopology(topology, h.genomeSize) || FlatNetwork::weightCount(topology) != h.genomeSize)
+    {
+        std::cerr << path << ": topologia sieci nie pasuje do rozmiaru genotypu" << std::endl;
+        return false;
+    }
+
+    out.header = h;
+    out.topology = std::move(topology);
+    out.genomes.resize(genomeCount);
+    std::memcpy(out.genomes.data(), p, genomeCount * sizeof(double));
+    p += genomeCount * sizeof(double);
+    out.fitness.resize(h.populationSize);
+    std::memcpy(out.fitness.data(), p, h.populationSize * sizeof(double));
+    p += h.populationSize * sizeof(double);
+    out.config.assign(p, h.configSize);
+    return true;
+}
+
+// Przywraca genotypy i fitness z migawki. Populacja musi mieć ten sam rozmiar, topologię, długość genotypu i liczbę laserów
+inline bool restoreSnapshot(const Snapshot &snap, Population &pop)
+{
+    if (snap.header.populationSize != pop.size || snap.topology != pop.topology || snap.header.laserCount != pop.laserCount ||
+        snap.header.genomeSize != pop.genomeSize || snap.genomes.size() != pop.genomes.size())
+    {
+        std::cerr << "Migawka nie pasuje do konfiguracji (populacja " << snap.header.populationSize
+                  << ", lasery " << snap.header.laserCount << ")" << std::endl;
+        return false;
+    }
+    std::copy(snap.genomes.begin(), snap.genomes.end(), pop.genomes.begin());
+    std::copy(snap.fitness.begin(), snap.fitness.end(), pop.fitness.begin());
+    return true;
+}
+
+// Zapis migawek w tle. save() tylko kopiuje stan do bufora, a plik zapisuje osobny wątek,
+// więc symulacja nie czeka na dysk. Jeśli poprzedni zapis jeszcze trwa, czekająca migawka
+// jest zastępowana nowszą (zapisywana jest zawsze najnowsza)
+class SnapshotWriter
+{
+public:
+    SnapshotWriter() : worker([this]
+                              { writerLoop(); }) {}
+
+    ~SnapshotWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    SnapshotWriter(const SnapshotWriter &) = delete;
+    SnapshotWriter &operator=(const SnapshotWriter &) = delete;
+
+    void save(const std::string &path, const Population &pop, int generation, std::uint64_t seed, const Curriculum &cur)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        serializeSnapshot(pending, pop, generation, seed, cur);
+        pendingPath = path;
+        hasPending = true;
+        cv.notify_all();
+    }
+
+    // Czeka na zapisanie wszystkich zleconych migawek
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]
+                { return !hasPending && !writing; });
+    }
+
+private:
+    void writerLoop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            cv.wait(lock, [this]
+                    { return stopping || hasPending; });
+            if (!hasPending)
+                return;
+
+            // zamiana buforów - zapis bez trzymania muteksu
+            std::swap(pending, writingData);
+            std::string path = pendingPath;
+            hasPending = false;
+            writing = true;
+            lock.unlock();
+
+            if (!writeFileAtomic(path, writingData))
+                std::cerr << "Nie można zapisać migawki: " << path << std::endl;
+
+            lock.lock();
+            writing = false;
+            cv.notify_all();
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<char> pending;
+    std::vector<char> writingData;
+    std::string pendingPath;
+    bool hasPending = false;
+    bool writing = false;
+    bool stopping = false;
+    std::thread worker; // ostatnie pole - startuje po zainicjalizowaniu pozostałych
+};
+
+#endif // SNAPSHOT_H
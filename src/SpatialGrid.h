@@ -0,0 +1,87 @@
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "Geometry.h"
+
+// Statyczny indeks przestrzenny przeszkód - jednorodna siatka komórek.
+// Budowany raz dla toru; każda komórka zna przeszkody, które na nią zachodzą (listy w układzie CSR:
+// przeszkody komórki c to items[start[c] .. start[c + 1])). Przeszkoda obejmująca kilka komórek
+// występuje w każdej z nich, więc zapytania mogą zwrócić ją kilka razy.
+struct ObstacleGrid
+{
+    float originX = 0.f, originY = 0.f;
+    float cellSize = 1.f;
+    int cols = 0, rows = 0;
+    std::vector<int> start;
+    std::vector<int> items;
+
+    bool empty() const { return cols == 0; }
+
+    int cellX(float x) const { return std::min(cols - 1, std::max(0, (int)std::floor((x - originX) / cellSize))); }
+    int cellY(float y) const { return std::min(rows - 1, std::max(0, (int)std::floor((y - originY) / cellSize))); }
+
+    bool contains(float x, float y) const
+    {
+        return x >= originX && y >= originY && x < originX + cols * cellSize && y < originY + rows * cellSize;
+    }
+
+    // Buduje siatkę pokrywającą obszar [0, width] x [0, height] razem ze wszystkimi przeszkodami.
+    // Liczba komórek rośnie z pierwiastkiem liczby przeszkód (ok. 2 komórki na przeszkodę w każdym wymiarze)
+    void build(const std::vector<Box> &boxes, float width, float height)
+    {
+        float minX = 0.f, minY = 0.f, maxX = width, maxY = height;
+        for (const Box &b : boxes)
+        {
+            minX = std::min(minX, b.minX);
+            minY = std::min(minY, b.minY);
+            maxX = std::max(maxX, b.maxX);
+            maxY = std::max(maxY, b.maxY);
+        }
+        int perSide = std::min(128, std::max(4, 2 * (int)std::ceil(std::sqrt((float)boxes.size()))));
+        originX = minX;
+        originY = minY;
+        cellSize = std::max(maxX - minX, maxY - minY) / perSide;
+        cols = std::max(1, (int)std::ceil((maxX - minX) / cellSize));
+        rows = std::max(1, (int)std::ceil((maxY - minY) / cellSize));
+
+        // dwa przejścia: zliczenie, potem wypełnienie list komórek
+        start.assign(cols * rows + 1, 0);
+        for (const Box &b : boxes)
+            forEachCell(b, [&](int c)
+                        { start[c + 1]++; });
+        for (int c = 0; c < cols * rows; ++c)
+            start[c + 1] += start[c];
+        items.assign(start.back(), 0);
+        std::vector<int> fill(start.begin(), start.end() - 1);
+        for (int i = 0; i < (int)boxes.size(); ++i)
+            forEachCell(boxes[i], [&](int c)
+                        { items[fill[c]++] = i; });
+    }
+
+    // wywołuje f(numer komórki) dla komórek, na które zachodzi prostokąt
+    template <class F>
+    void forEachCell(const Box &b, F &&f) const
+    {
+        int x0 = cellX(b.minX), x1 = cellX(b.maxX);
+        int y0 = cellY(b.minY), y1 = cellY(b.maxY);
+        for (int y = y0; y <= y1; ++y)
+            for (int x = x0; x <= x1; ++x)
+                f(y * cols + x);
+    }
+
+    // wywołuje f(numer przeszkody) dla przeszkód z komórek, na które zachodzi prostokąt (z możliwymi powtórzeniami)
+    template <class F>
+    void forEachCandidate(const Box &b, F &&f) const
+    {
+        forEachCell(b, [&](int c)
+                    {
+            for (int k = start[c]; k < start[c + 1]; ++k)
+                f(items[k]); });
+    }
+};
+
+#endif // SPATIAL_GRID_H
@@ -0,0 +1,158 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+
+// Pula wątków z podkradaniem pracy (work stealing) dla pętli równoległych.
+// parallelFor() dzieli zakres na porcje po `grain` elementów i rozdaje każdemu wątkowi ciągły blok porcji.
+// Wątek, który skończy swój blok, podkrada porcje z bloków pozostałych - martwe rakiety sprawiają,
+// że porcje mają różny koszt, więc statyczny podział zostawiałby rdzenie bezczynne.
+// Wątek wywołujący też wykonuje pracę (jako wątek 0). parallelFor() wraca dopiero po wykonaniu wszystkich porcji.
+class ThreadPool
+{
+public:
+    // threads <= 0 oznacza liczbę rdzeni
+    explicit ThreadPool(int threads = 0)
+    {
+        if (threads <= 0)
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        threadCount = threads;
+        queues.reset(new Queue[threadCount]);
+        for (int id = 1; id < threadCount; ++id)
+            workers.emplace_back([this, id]
+                                 { workerLoop(id); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wakeCv.notify_all();
+        for (auto &w : workers)
+            w.join();
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    int size() const { return threadCount; }
+
+    // Wywołuje f(chunkBegin, chunkEnd) dla porcji zakresu [begin, end)
+    template <class F>
+    void parallelFor(int begin, int end, int grain, F &&f)
+    {
+        if (end <= begin)
+            return;
+        grain = std::max(1, grain);
+        int chunks = (end - begin + grain - 1) / grain;
+
+        // bez dodatkowych wątków (lub dla jednej porcji) wszystko liczone w miejscu
+        if (threadCount == 1 || chunks == 1)
+        {
+            for (int c = 0; c < chunks; ++c)
+                f(begin + c * grain, std::min(end, begin + (c + 1) * grain));
+            return;
+        }
+
+        using Fn = typename std::remove_reference<F>::type;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobContext = const_cast<void *>(static_cast<const void *>(&f));
+            jobFunction = [](void *ctx, int b, int e)
+            { (*static_cast<Fn *>(ctx))(b, e); };
+            jobBegin = begin;
+            jobEnd = end;
+            jobGrain = grain;
+            for (int t = 0; t < threadCount; ++t)
+            {
+                queues[t].next.store((int)((long long)chunks * t / threadCount), std::memory_order_relaxed);
+                queues[t].end = (int)((long long)chunks * (t + 1) / threadCount);
+            }
+            pending = threadCount - 1;
+            epoch++;
+        }
+        wakeCv.notify_all();
+
+        runChunks(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        doneCv.wait(lock, [this]
+                    { return pending == 0; });
+    }
+
+private:
+    // blok porcji jednego wątku; next jest zwiększany atomowo przez właściciela i złodziei
+    struct alignas(64) Queue
+    {
+        std::atomic<int> next{0};
+        int end = 0;
+    };
+
+    void runChunks(int id)
+    {
+        // najpierw własny blok, potem podkradanie od kolejnych wątków
+        for (int k = 0; k < threadCount; ++k)
+        {
+            Queue &q = queues[(id + k) % threadCount];
+            while (true)
+            {
+                int c = q.next.fetch_add(1, std::memory_order_relaxed);
+                if (c >= q.end)
+                    break;
+                int b = jobBegin + c * jobGrain;
+                jobFunction(jobContext, b, std::min(jobEnd, b + jobGrain));
+            }
+        }
+    }
+
+    void workerLoop(int id)
+    {
+        long long seenEpoch = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wakeCv.wait(lock, [&]
+                            { return stopping || epoch != seenEpoch; });
+                if (stopping)
+                    return;
+                seenEpoch = epoch;
+            }
+
+            runChunks(id);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0)
+                doneCv.notify_one();
+        }
+    }
+
+    int threadCount = 1;
+    std::vector<std::thread> workers;
+    std::unique_ptr<Queue[]> queues;
+
+    std::mutex mutex;
+    std::condition_variable wakeCv;
+    std::condition_variable doneCv;
+    long long epoch = 0;
+    int pending = 0;
+    bool stopping = false;
+
+    // bieżące zadanie (ustawiane pod muteksem przed zwiększeniem epoch)
+    void *jobContext = nullptr;
+    void (*jobFunction)(void *, int, int) = nullptr;
+    int jobBegin = 0;
+    int jobEnd = 0;
+    int jobGrain = 1;
+};
+
+#endif // THREAD_POOL_H
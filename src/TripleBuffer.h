@@ -0,0 +1,44 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+
+// Potrójny bufor bez blokad dla jednego pisarza i jednego czytelnika.
+// Pisarz wypełnia writeBuffer() i publikuje go przez publish(); czytelnik przez acquire() dostaje
+// najnowszy opublikowany bufor i czyta go przez readBuffer(). Żadna strona nigdy nie czeka na drugą:
+// pisarz zawsze ma wolny bufor, a czytelnik trzyma swój, dopóki nie poprosi o nowszy.
+// Pośredni bufor wymieniany jest jedną operacją atomową; bit DIRTY oznacza, że leży w nim nieodczytana publikacja.
+template <class T>
+class TripleBuffer
+{
+public:
+    T &writeBuffer() { return buffers[back]; }
+
+    // Oddaje zapisany bufor czytelnikowi (poprzednia nieodczytana publikacja jest porzucana)
+    void publish()
+    {
+        back = middle.exchange(back | DIRTY, std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Przejmuje najnowszą publikację; zwraca false, jeśli od ostatniego razu nic nowego nie opublikowano
+    bool acquire()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & DIRTY))
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    const T &readBuffer() const { return buffers[front]; }
+
+private:
+    static const int INDEX = 3;
+    static const int DIRTY = 4;
+
+    T buffers[3];
+    int front = 0;              // używany tylko przez czytelnika
+    int back = 2;               // używany tylko przez pisarza
+    std::atomic<int> middle{1}; // indeks pośredniego bufora | DIRTY
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -1,9 +1,10 @@
 #ifndef UTILS_H
 #define UTILS_H
 
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 #include <cmath>
-#include <random>
+
+#include "Random.h"
 
 // oblicza punkt przecięcia dwóch odcinków. jest to funkcja matematyczna niezbędna do działania "oczu" (laserów) rakiety – sprawdza, czy promień lasera przecina ścianę przeszkody
 inline bool getLineIntersection(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3, sf::Vector2f p4, sf::Vector2f &intersection)
@@ -30,13 +31,10 @@ inline bool getLineIntersection(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p
     return false;
 }
 
-// generuje losową liczbę zmiennoprzecinkową z zakresu [0, 1]
+// generuje losową liczbę zmiennoprzecinkową z zakresu [0, 1) z generatora bieżącego wątku
 inline double randomDouble()
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<> dis(0.0, 1.0);
-    return dis(gen);
+    return threadRng().uniform();
 }
 
 // generuje losową liczbę zmiennoprzecinkową z zakresu [min, max]
@@ -0,0 +1,94 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <SFML/System/Vector2.hpp>
+#include <vector>
+
+#include "Geometry.h"
+#include "SpatialGrid.h"
+
+// Przeszkody w układzie struktury tablic - dane wejściowe jądra czujników (Sensor.h)
+struct ObstacleArrays
+{
+    std::vector<float> minX, minY, maxX, maxY;
+
+    void add(const Box &b)
+    {
+        minX.push_back(b.minX);
+        minY.push_back(b.minY);
+        maxX.push_back(b.maxX);
+        maxY.push_back(b.maxY);
+    }
+
+    int size() const { return (int)minX.size(); }
+};
+
+// od tej liczby przeszkód czujniki i kolizje korzystają z siatki zamiast przeglądać wszystkie przeszkody
+const int GRID_MIN_OBSTACLES = 32;
+
+// Świat symulacji - czyste dane bez obiektów SFML, kształty do rysowania tworzy dopiero Renderer
+struct World
+{
+    float width = 1000.f;
+    float height = 1000.f;
+
+    std::vector<Box> przeszkody;
+    ObstacleArrays przeszkodySoA; // te same przeszkody, dla czujników
+    ObstacleGrid grid;            // indeks przestrzenny przeszkód, budowany przez finalize()
+    // Granice checkpointów (okrąg wpisany w kwadrat). Celem nawigacji jest lewy górny róg, tak jak pozycja sf::CircleShape
+    std::vector<Box> checkpoints;
+    sf::Vector2f cel = {100.f, 100.f};
+    float celRadius = 50.f;
+    sf::Vector2f startPos = {100.f, 900.f};
+
+    void dodajPrzeszkode(sf::Vector2f size, sf::Vector2f pos)
+    {
+        Box b = {pos.x, pos.y, pos.x + size.x, pos.y + size.y};
+        przeszkody.push_back(b);
+        przeszkodySoA.add(b);
+    }
+
+    void dodajCheckpoint(sf::Vector2f pos, float radius = 70.f)
+    {
+        checkpoints.push_back({pos.x, pos.y, pos.x + 2.f * radius, pos.y + 2.f * radius});
+    }
+
+    int checkpointCount() const { return (int)checkpoints.size(); }
+
+    bool useGrid() const { return (int)przeszkody.size() >= GRID_MIN_OBSTACLES && !grid.empty(); }
+
+    // Przelicza dane pomocnicze po dodaniu wszystkich przeszkód (indeks przestrzenny)
+    void finalize()
+    {
+        grid.build(przeszkody, width, height);
+    }
+};
+
+// Buduje domyślny tor przeszkód
+inline World createWorld()
+{
+    World world;
+
+    // Dodawanie przeszkód i krawędzi
+    world.dodajPrzeszkode({600.f, 20.f}, {400.f, 450.f});
+    world.dodajPrzeszkode({600.f, 20.f}, {0.f, 220.f});
+    world.dodajPrzeszkode({600.f, 20.f}, {0.f, 720.f});
+    world.dodajPrzeszkode({1000.f, 10.f}, {0.f, 0.f});
+    world.dodajPrzeszkode({1000.f, 10.f}, {0.f, 990.f});
+    world.dodajPrzeszkode({10.f, 1000.f}, {0.f, 0.f});
+    world.dodajPrzeszkode({10.f, 1000.f}, {990.f, 0.f});
+
+    // Dodawanie checkpointów
+    world.dodajCheckpoint({700.f, 620.f});
+    world.dodajCheckpoint({100.f, 430.f});
+    world.dodajCheckpoint({700.f, 130.f});
+
+    // Finalny checkpoint
+    world.cel = {100.f, 100.f};
+    world.startPos = {100.f, 900.f};
+
+    world.finalize();
+    return world;
+}
+
+#endif // WORLD_H
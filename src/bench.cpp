@@ -0,0 +1,201 @@
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+#include "siec/NeuralNetwork.h"
+#include "siec/FlatNetwork.h"
+#include "siec/FixedNetwork.h"
+#include "siec/BatchedNetwork.h"
+#include "siec/utils/MultiplyMatrix.h"
+
+#include "World.h"
+#include "Population.h"
+#include "Rocket.h"
+#include "GeneticAlgorithm.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include "Sensor.h"
+#include "Config.h"
+
+// Benchmarki gorących ścieżek symulacji. Każdy pomiar podaje czas jednej operacji (ns/op),
+// a kroki symulacji dodatkowo przepustowość w krokach rakiet na sekundę.
+// Użycie: bench [liczba_wątków]  (domyślnie wszystkie rdzenie)
+
+// wynik obliczeń, żeby kompilator nie usunął mierzonego kodu
+static volatile double sink = 0.0;
+
+// Mierzy fn() powtarzane, aż pomiar potrwa co najmniej ~0.2 s. Zwraca ns na wywołanie fn()
+template <class F>
+double measure(F &&fn)
+{
+    using clock = std::chrono::steady_clock;
+    fn(); // rozgrzewka
+    long long iterations = 1;
+    while (true)
+    {
+        auto start = clock::now();
+        for (long long i = 0; i < iterations; ++i)
+            fn();
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        if (ns > 2e8 || iterations >= (1ll << 30))
+            return ns / iterations;
+        iterations *= std::max(2ll, (long long)(2e8 / std::max(ns, 1.0)));
+    }
+}
+
+void report(const std::string &name, double nsPerOp, const std::string &extra = "")
+{
+    std::cout << std::left << std::setw(52) << name << std::right << std::setw(14) << std::fixed << std::setprecision(1)
+              << nsPerOp << " ns/op" << extra << std::endl;
+}
+
+// populacja w połowie lotu - rakiety rozrzucone po torze, żeby czujniki i kolizje miały realistyczną pracę
+void scatter(Population &pop, const World &world)
+{
+    Rng rng(12345);
+    pop.resetAll(world.startPos);
+    for (int i = 0; i < pop.size; ++i)
+    {
+        pop.posX[i] = (float)rng.range(20.0, 980.0);
+        pop.posY[i] = (float)rng.range(20.0, 980.0);
+        pop.rotation[i] = (float)rng.range(0.0, 360.0);
+        pop.velX[i] = (float)rng.range(-2.0, 2.0);
+        pop.velY[i] = (float)rng.range(-2.0, 2.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int threads = 0;
+    if (argc > 1 && !parseNumber(argv[1], threads))
+    {
+        std::cerr << "Niepoprawna liczba wątków: " << argv[1] << "\nUżycie: bench [liczba_wątków]" << std::endl;
+        return 1;
+    }
+    ThreadPool pool(threads);
+    setMasterSeed(1);
+
+    World world = createWorld();
+    std::cout << "Wątki: " << pool.size() << std::endl;
+
+    // --- sieć neuronowa ---
+    {
+        const std::vector<int> &topology = experimentTopology();
+        NeuralNetwork nn(topology);
+        std::vector<double> input(topology[0], 0.25);
+        report("NeuralNetwork::feedForward 13-8-3", measure([&]
+                                                            {
+            nn.setCurrentInput(input);
+            nn.feedForward();
+            sink = sink + nn.getOutputs()[0]; }));
+
+        FlatNetwork flat(topology);
+        std::fill(flat.inputData(), flat.inputData() + topology[0], 0.25);
+        report("FlatNetwork::feedForward 13-8-3", measure([&]
+                                                          {
+            flat.feedForward();
+            sink = sink + flat.outputData()[0]; }));
+
+        FixedNetwork<13, 8, 3> fixed;
+        std::fill(fixed.inputData(), fixed.inputData() + 13, 0.25);
+        report("FixedNetwork<13,8,3>::feedForward", measure([&]
+                                                           {
+            fixed.feedForward();
+            sink = sink + fixed.outputData()[0]; }));
+
+        Matrix a(1, 13, true);
+        Matrix b(13, 8, true);
+        report("MultiplyMatrix::execute 1x13 * 13x8", measure([&]
+                                                              {
+            utils::MultiplyMatrix m(&a, &b);
+            Matrix *c = m.execute();
+            sink = sink + c->getValue(0, 0);
+            delete c; }));
+    }
+
+    // --- czujniki na gęstym torze: liniowe jądro SIMD vs siatka przeszkód ---
+    {
+        World dense;
+        dense.width = dense.height = 2000.f;
+        Rng rng(7);
+        for (int k = 0; k < 400; ++k)
+            dense.dodajPrzeszkode({(float)rng.range(5.0, 60.0), (float)rng.range(5.0, 60.0)},
+                                  {(float)rng.range(0.0, 2000.0), (float)rng.range(0.0, 2000.0)});
+        dense.finalize();
+
+        RayBatch rays;
+        prepareRays(rays, laserRig(), 0.6f, 0.8f, experiment().maxLaserDist);
+        report("castRays liniowo [400 przeszkód]", measure([&]
+                                                           {
+            castRays(dense.przeszkodySoA, 1000.f, 1000.f, rays);
+            sink = sink + rays.t[0]; }));
+        report("castRaysGrid [400 przeszkód]", measure([&]
+                                                       {
+            castRaysGrid(dense.grid, dense.przeszkodySoA, 1000.f, 1000.f, rays);
+            sink = sink + rays.t[0]; }));
+    }
+
+    for (int n : {100, 1000, 10000})
+    {
+        std::cout << "--- populacja " << n << " ---" << std::endl;
+        std::string suffix = " [N=" + std::to_string(n) + "]";
+
+        Population pop;
+        pop.resize(n, experiment().laserCount(), experimentTopology());
+        scatter(pop, world);
+
+        // wsadowe przejście w przód całej populacji
+        for (int i = 0; i < n; ++i)
+            std::fill(pop.net.inputRow(i), pop.net.inputRow(i) + experimentTopology()[0], 0.25);
+        double batchNs = measure([&]
+                                 {
+            pop.net.feedForward(n, pop.genomes.data(), pop.genomeSize, nullptr);
+            sink = sink + pop.net.outputRow(n - 1)[0]; });
+        report("BatchedNetwork::feedForward / rakieta" + suffix, batchNs / n);
+
+        double sharedNs = measure([&]
+                                  {
+            pop.net.feedForwardShared(n, pop.genome(0));
+            sink = sink + pop.net.outputRow(n - 1)[0]; });
+        report("BatchedNetwork::feedForwardShared / wiersz" + suffix, sharedNs / n);
+
+        // czujniki na domyślnym torze
+        double senseNs = measure([&]
+                                 {
+            for (int i = 0; i < n; ++i)
+                sense(pop, i, world);
+            sink = sink + pop.laserDist[0]; });
+        report("sense / rakieta" + suffix, senseNs / n);
+
+        // pełny krok symulacji (jednowątkowo i na puli); rakiety są wskrzeszane, gdy zginą,
+        // żeby mierzyć stałą liczbę aktywnych rakiet
+        for (ThreadPool *p : {(ThreadPool *)nullptr, &pool})
+        {
+            scatter(pop, world);
+            int stepsDone = 0;
+            double stepNs = measure([&]
+                                    {
+                stepPopulation(pop, world, p);
+                if (++stepsDone % 50 == 0)
+                    scatter(pop, world); });
+            double rocketStepsPerSec = 1e9 / stepNs * n;
+            std::string name = p ? "stepPopulation (pula)" : "stepPopulation (1 wątek)";
+            report(name + suffix, stepNs, "   " + std::to_string((long long)rocketStepsPerSec) + " kroków rakiet/s");
+        }
+
+        // ewolucja jednego pokolenia (fitness ustawiany od nowa, bo evolve() resetuje populację)
+        int generation = 0;
+        double evolveNs = measure([&]
+                                  {
+            for (int i = 0; i < n; ++i)
+                pop.fitness[i] = (double)((i * 7919) % n);
+            evolve(pop, world.startPos, 1, ++generation, &pool);
+            sink = sink + pop.genomes[0]; });
+        report("evolve" + suffix, evolveNs);
+    }
+
+    return 0;
+}
@@ -0,0 +1,344 @@
+#include <vector>
+#include <cstdint>
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+#include "World.h"
+#include "Population.h"
+#include "GeneticAlgorithm.h"
+#include "Simulation.h"
+#include "ThreadPool.h"
+#include "MapLoader.h"
+#include "Curriculum.h"
+#include "Snapshot.h"
+#include "GenomeFile.h"
+#include "Profiler.h"
+#include "Metrics.h"
+#include "Islands.h"
+#include "Config.h"
+#ifndef _WIN32
+#include "Distributed.h"
+#endif
+
+// Trening bez okna - symulacja leci tak szybko, jak pozwala procesor.
+// Nie tworzy okna, nie wczytuje tekstur ani czcionek, więc działa na maszynach bez wyświetlacza.
+// Użycie: headless [liczba_pokoleń] [liczba_wątków] [ziarno] [tor...] [--starts K] [--agg mean|min|pNN]
+// (domyślnie bez końca, wszystkie rdzenie, losowe ziarno, wbudowany tor; tor to plik .map lub .mapb).
+// Kilka torów lub --starts > 1 włącza ocenę każdego genotypu we wszystkich scenariuszach (Curriculum.h),
+// --agg wybiera sposób łączenia wyników (domyślnie średnia).
+// --checkpoint plik [--checkpoint-every N] zapisuje w tle migawkę co N pokoleń (domyślnie 10) i po ostatnim,
+// --resume plik wznawia trening z migawki (ziarno, ustawienia oceny i konfiguracja pochodzą z migawki;
+// --config/--set różne od konfiguracji migawki kończą program błędem).
+// --export-best plik zapisuje po każdym pokoleniu genotyp najlepszej rakiety (do odtworzenia programem replay),
+// --export-format f64|f32|bf16|i8 wybiera precyzję zapisanych wag (domyślnie f64).
+// --stop-stall N kończy pokolenie, gdy przez N kroków żadna rakieta nie zbliżyła się do celu,
+// --stop-stuck kończy je, gdy wszystkie żywe rakiety stoją w miejscu (domyślnie pokolenie trwa lifetime kroków).
+// --metrics plik.csv zapisuje statystyki każdego pokolenia (fitness max/średni/mediana, ukończone, histogram CP,
+// średni czas dotarcia do celu, różnorodność genotypów); statystyki wypisuje w tle osobny wątek.
+// --islands M [--migrate-every N] [--migrants K] uruchamia model wyspowy: M populacji po population rakiet,
+// każda we własnym wątku, co N pokoleń (domyślnie 10) k najlepszych (domyślnie 4) przechodzi na następną wyspę;
+// --metrics plik.csv daje wtedy osobny plik na wyspę (plik-0.csv, plik-1.csv, ...), bez migawek i --export-best.
+// --profile plik.csv|plik.json zapisuje czasy faz każdego pokolenia, --trace plik.json [--trace-from K] [--trace-ticks N]
+// zapisuje ślad Chrome trace_event dla N kroków od kroku K (wymaga kompilacji z -DROCKETS_PROFILE=ON);
+// w modelu wyspowym kroki są liczone łącznie dla wszystkich wysp, a --profile nie jest obsługiwane.
+// --coordinator adres --workers W [--wait-workers R] [--batch B] rozdziela ocenę pokoleń między procesy (Distributed.h):
+// uruchamia W lokalnych procesów roboczych i czeka dodatkowo na R robotników uruchomionych ręcznie
+// (headless --worker adres [liczba_wątków], także na innych maszynach); adres to ścieżka gniazda uniksowego
+// albo host:port dla TCP, B - liczba genotypów w partii (domyślnie 16). Tylko Linux/POSIX.
+// --config plik.cfg i --set klucz=wartość (można powtarzać, np. --set population=200 --set hidden=16,8) ustawiają
+// parametry eksperymentu: populację, mutację, elityzm, turniej, lifetime, warstwy ukryte, lasery i fizykę (Config.h);
+// --print-config wypisuje wynikową konfigurację w formacie pliku i kończy program.
+// Ten sam ziarno daje identyczny przebieg niezależnie od liczby wątków
+int main(int argc, char *argv[])
+{
+    int maxGenerations = 0;
+    int threads = 0;
+    bool seedGiven = false;
+    std::uint64_t seed = 0;
+    std::vector<std::string> mapPaths;
+    Curriculum curriculum;
+    std::string checkpointPath, resumePath, exportPath;
+    int checkpointEvery = 10;
+    WeightFormat exportFormat = WeightFormat::F64;
+    std::string profilePath, tracePath, metricsPath;
+    IslandSettings islandSettings;
+    std::uint64_t traceFrom = 1, traceTicks = 100;
+    std::string coordinatorAddress;
+    int localWorkers = 0, remoteWorkers = 0, batchSize = 16;
+    ExperimentConfig config;
+    bool printConfig = false;
+    bool configGiven = false;
+
+#ifndef _WIN32
+    // proces roboczy oceny rozproszonej - cała konfiguracja przychodzi od koordynatora
+    if (argc >= 3 && std::string(argv[1]) == "--worker")
+    {
+        int workerThreads = 0;
+        if (argc >= 4 && !parseNumber(argv[3], workerThreads))
+        {
+            std::cerr << "Niepoprawna liczba wątków: " << argv[3] << "\nUżycie: headless --worker adres [liczba_wątków]" << std::endl;
+            return 1;
+        }
+        return runWorker(argv[2], workerThreads);
+    }
+#endif
+
+    int positional = 0;
+    for (int a = 1; a < argc; ++a)
+    {
+        std::string arg = argv[a];
+        bool numberOk = true;
+        if (arg == "--config" && a + 1 < argc)
+        {
+            if (!loadExperiment(argv[++a], config))
+                return 1;
+            configGiven = true;
+        }
+        else if (arg == "--set" && a + 1 < argc)
+        {
+            if (!applyExperimentOption(argv[++a], config))
+                return 1;
+            configGiven = true;
+        }
+        else if (arg == "--print-config")
+            printConfig = true;
+        else if (arg == "--starts" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], curriculum.startsPerMap, 1);
+        else if (arg == "--agg" && a + 1 < argc)
+        {
+            if (!parseAggregate(argv[++a], curriculum.aggregate, curriculum.percentile))
+            {
+                std::cerr << "Nieznany sposób agregacji: " << argv[a] << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--stop-stall" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], curriculum.earlyStop.stallTicks, 0);
+        else if (arg == "--stop-stuck")
+            curriculum.earlyStop.allStuck = true;
+        else if (arg == "--islands" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], islandSettings.islands, 1);
+        else if (arg == "--migrate-every" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], islandSettings.migrateEvery, 1);
+        else if (arg == "--migrants" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], islandSettings.migrants, 0);
+        else if (arg == "--coordinator" && a + 1 < argc)
+            coordinatorAddress = argv[++a];
+        else if (arg == "--workers" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], localWorkers, 0);
+        else if (arg == "--wait-workers" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], remoteWorkers, 0);
+        else if (arg == "--batch" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], batchSize, 1);
+        else if (arg == "--metrics" && a + 1 < argc)
+            metricsPath = argv[++a];
+        else if (arg == "--profile" && a + 1 < argc)
+            profilePath = argv[++a];
+        else if (arg == "--trace" && a + 1 < argc)
+            tracePath = argv[++a];
+        else if (arg == "--trace-from" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], traceFrom);
+        else if (arg == "--trace-ticks" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], traceTicks);
+        else if (arg == "--checkpoint" && a + 1 < argc)
+            checkpointPath = argv[++a];
+        else if (arg == "--checkpoint-every" && a + 1 < argc)
+            numberOk = parseNumber(argv[++a], checkpointEvery, 1);
+        else if (arg == "--resume" && a + 1 < argc)
+            resumePath = argv[++a];
+        else if (arg == "--export-best" && a + 1 < argc)
+            exportPath = argv[++a];
+        else if (arg == "--export-format" && a + 1 < argc)
+        {
+            if (!parseWeightFormat(argv[++a], exportFormat))
+            {
+                std::cerr << "Nieznany format wag: " << argv[a] << std::endl;
+                return 1;
+            }
+        }
+        else if (positional == 0)
+            numberOk = parseNumber(arg, maxGenerations), positional++;
+        else if (positional == 1)
+            numberOk = parseNumber(arg, threads), positional++;
+        else if (positional == 2)
+            numberOk = parseNumber(arg, seed), seedGiven = true, positional++;
+        else
+            mapPaths.push_back(arg);
+
+        if (!numberOk)
+        {
+            std::cerr << "Niepoprawna liczba: " << argv[a] << "\nUżycie: headless [liczba_pokoleń] [liczba_wątków] [ziarno] [tor...] [opcje]"
+                      << " (opis opcji na początku src/headless.cpp i w README.md)" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!validateExperiment(config, "konfiguracja"))
+        return 1;
+
+    Snapshot snapshot;
+    if (!resumePath.empty())
+    {
+        if (!loadSnapshot(resumePath, snapshot))
+            return 1;
+        seed = snapshot.header.masterSeed;
+        seedGiven = true;
+        curriculum.startsPerMap = snapshot.header.startsPerMap;
+        curriculum.startJitter = snapshot.header.startJitter;
+        curriculum.aggregate = (FitnessAggregate)snapshot.header.aggregate;
+        curriculum.percentile = snapshot.header.percentile;
+
+        // wznowienie z inną konfiguracją nie byłoby kontynuacją tego samego treningu
+        ExperimentConfig snapshotConfig;
+        if (!parseExperiment(snapshot.config, resumePath, snapshotConfig) || !validateExperiment(snapshotConfig, resumePath))
+            return 1;
+        if (configGiven && formatExperiment(config) != snapshot.config)
+        {
+            std::cerr << "Konfiguracja różni się od zapisanej w migawce " << resumePath
+                      << " (--print-config --resume plik wypisuje zapisaną)" << std::endl;
+            return 1;
+        }
+        config = snapshotConfig;
+    }
+
+    setExperiment(config);
+    if (printConfig)
+    {
+        std::cout << formatExperiment(experiment());
+        return 0;
+    }
+
+    if (!PROFILING_ENABLED && (!profilePath.empty() || !tracePath.empty()))
+        std::cerr << "Uwaga: program zbudowany bez ROCKETS_PROFILE - pomiary nie będą zapisane" << std::endl;
+    if (!profilePath.empty() && !profiler().openLog(profilePath))
+        return 1;
+    if (!tracePath.empty())
+        profiler().startTrace(tracePath, traceFrom, traceTicks);
+
+    if (seedGiven)
+        setMasterSeed(seed);
+    std::cout << "Ziarno: " << masterSeed() << std::endl;
+
+    ThreadPool pool(threads);
+
+    std::vector<World> worlds;
+    if (mapPaths.empty())
+        worlds.push_back(createWorld());
+    for (const std::string &path : mapPaths)
+    {
+        worlds.emplace_back();
+        if (!loadMap(path, worlds.back()))
+            return 1;
+    }
+    for (const World &w : worlds)
+        curriculum.maps.push_back(&w);
+    if (curriculum.scenarioCount() > 1)
+        std::cout << "Scenariusze: " << curriculum.scenarioCount() << std::endl;
+
+    int checkpointCount = 0;
+    for (const World &w : worlds)
+        checkpointCount = std::max(checkpointCount, w.checkpointCount());
+
+    if (islandSettings.islands > 1)
+    {
+        if (!coordinatorAddress.empty())
+            std::cerr << "Uwaga: model wyspowy nie obsługuje --coordinator" << std::endl;
+        if (!checkpointPath.empty() || !resumePath.empty() || !exportPath.empty())
+            std::cerr << "Uwaga: model wyspowy nie obsługuje --checkpoint, --resume ani --export-best" << std::endl;
+        if (!profilePath.empty())
+            std::cerr << "Uwaga: model wyspowy nie zapisuje --profile (brak wspólnej granicy pokoleń)" << std::endl;
+        std::cout << "Wyspy: " << islandSettings.islands << std::endl;
+        IslandModel model(islandSettings, curriculum, masterSeed());
+        if (!model.openMetrics(metricsPath, checkpointCount, curriculum.earlyStop.enabled()))
+            return 1;
+        auto startTime = std::chrono::steady_clock::now();
+        model.run(maxGenerations);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        std::cout << "Pokoleń: " << maxGenerations << " na " << islandSettings.islands << " wyspach w " << seconds << " s" << std::endl;
+        return 0;
+    }
+
+    Population population;
+    createPopulation(population, worlds.front());
+
+    int generation = 1;
+    if (!resumePath.empty())
+    {
+        if (snapshot.header.scenarioMaps != (int)curriculum.maps.size())
+            std::cerr << "Uwaga: migawka powstała na " << snapshot.header.scenarioMaps << " torach" << std::endl;
+        if (!restoreSnapshot(snapshot, population))
+            return 1;
+        // zapisane pokolenie było już ocenione - następne powstaje tak samo jak bez przerwy
+        evolve(population, worlds.front().startPos, masterSeed(), snapshot.header.generation, &pool);
+        generation = snapshot.header.generation + 1;
+        std::cout << "Wznowiono od pokolenia " << generation << std::endl;
+    }
+
+    MetricsWriter metrics(true, curriculum.earlyStop.enabled());
+    if (!metricsPath.empty() && !metrics.open(metricsPath, checkpointCount))
+        return 1;
+    MetricsCollector metricsCollector;
+    GenerationMetrics generationMetrics;
+
+#ifndef _WIN32
+    DistributedEvaluator distributed;
+    const bool useDistributed = !coordinatorAddress.empty();
+    if (useDistributed)
+    {
+        if (curriculum.earlyStop.enabled())
+            std::cerr << "Uwaga: przy ocenie rozproszonej reguły --stop-* działają w obrębie partii" << std::endl;
+        if (!distributed.start(argv[0], coordinatorAddress, localWorkers, remoteWorkers, curriculum, masterSeed(), batchSize))
+            return 1;
+        std::cout << "Robotnicy: " << distributed.workerCount() << std::endl;
+    }
+#else
+    if (!coordinatorAddress.empty())
+        std::cerr << "Uwaga: ocena rozproszona działa tylko w systemach POSIX" << std::endl;
+    const bool useDistributed = false;
+#endif
+
+    SnapshotWriter snapshotWriter;
+    auto startTime = std::chrono::steady_clock::now();
+
+    while (maxGenerations <= 0 || generation <= maxGenerations)
+    {
+        // Symulacja całego pokolenia we wszystkich scenariuszach bez czekania na klatki
+        GenerationStats stats;
+        const Population *flights = &curriculum.episodes;
+#ifndef _WIN32
+        if (useDistributed)
+        {
+            if (!distributed.evaluate(population, generation, stats))
+                return 1;
+            flights = &distributed.flights();
+        }
+        else
+#endif
+            stats = runCurriculum(curriculum, population, masterSeed(), generation, &pool);
+        metricsCollector.collect(generationMetrics, generation, stats, population, *flights, checkpointCount);
+        metrics.push(generationMetrics);
+
+        if (!exportPath.empty())
+        {
+            int best = (int)(std::max_element(population.fitness.begin(), population.fitness.end()) - population.fitness.begin());
+            if (!saveGenome(exportPath, population, best, generation, exportFormat))
+                std::cerr << "Nie można zapisać genotypu: " << exportPath << std::endl;
+        }
+
+        bool last = maxGenerations > 0 && generation == maxGenerations;
+        if (!checkpointPath.empty() && (generation % checkpointEvery == 0 || last))
+            snapshotWriter.save(checkpointPath, population, generation, masterSeed(), curriculum);
+
+        evolve(population, worlds.front().startPos, masterSeed(), generation, &pool);
+        PROFILE_GENERATION(generation);
+        generation++;
+    }
+
+    snapshotWriter.flush();
+    metrics.flush();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Pokoleń: " << generation - 1 << " w " << seconds << " s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+
+#include "World.h"
+#include "MapLoader.h"
+
+// Konwersja torów między formatem tekstowym (.map) i binarnym (.mapb).
+// Format wyjścia wybierany jest po rozszerzeniu pliku docelowego; format wejścia rozpoznawany po nagłówku.
+// Użycie: mapconv <wejście> <wyjście>
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Użycie: mapconv <wejście> <wyjście.map|wyjście.mapb>" << std::endl;
+        return 1;
+    }
+
+    World world;
+    if (!loadMap(argv[1], world))
+        return 1;
+
+    std::string out = argv[2];
+    bool binary = out.size() >= 5 && out.compare(out.size() - 5, 5, ".mapb") == 0;
+    if (!(binary ? saveMapBinary(out, world) : saveMapText(out, world)))
+    {
+        std::cerr << "Nie można zapisać toru: " << out << std::endl;
+        return 1;
+    }
+
+    std::cout << out << ": " << world.przeszkody.size() << " przeszkód, " << world.checkpointCount()
+              << " checkpointów, siatka " << world.grid.cols << "x" << world.grid.rows << std::endl;
+    return 0;
+}
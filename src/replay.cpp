@@ -0,0 +1,170 @@
+#include <SFML/Graphics.hpp>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "World.h"
+#include "Population.h"
+#include "Rocket.h"
+#include "GeneticAlgorithm.h"
+#include "Renderer.h"
+#include "MapLoader.h"
+#include "GenomeFile.h"
+#include "siec/FixedNetwork.h"
+#include "Config.h"
+
+// Odtwarzanie lotu jednej rakiety z zapisanego genotypu (headless --export-best).
+// Bez puli wątków i bez sieci wsadowej - populacja z jedną rakietą i jedna sieć skompilowana dla stałej topologii
+// (RocketNetwork). Genotyp o innej topologii (inne hidden/lasers w Config.h) liczy sieć wsadowa o jednym wierszu.
+// Użycie: replay <plik.genome> [tor] [--render] [--config plik.cfg] [--set klucz=wartość ...]
+// Bez --render wypisuje wynik lotu; z --render pokazuje lot w oknie i powtarza go do zamknięcia okna.
+// Warstwy ukryte pochodzą z pliku genotypu; lasery, fizyka i lifetime - z konfiguracji treningu (Config.h),
+// więc genotyp z treningu z --config trzeba odtwarzać z tym samym plikiem.
+
+// Sieć domyślnej topologii (8 laserów + 5 wejść, 8 neuronów ukrytych, 3 wyjścia) skompilowana z rozwiniętymi pętlami
+using RocketNetwork = FixedNetwork<13, 8, 3>;
+
+// Jeden krok lotu - te same fazy co stepChunk(), ale z pojedynczą siecią (net == nullptr - sieć wsadowa populacji)
+bool replayStep(Population &pop, const World &world, RocketNetwork *net)
+{
+    if (!pop.isActive(0))
+        return false;
+    pop.timeAlive[0]++;
+    sense(pop, 0, world);
+    checkCheckpoints(pop, 0, world);
+    if (net)
+    {
+        buildInputs(pop, 0, world, net->inputData());
+        net->feedForward();
+        applyControls(pop, 0, net->outputData());
+    }
+    else
+    {
+        buildInputs(pop, 0, world, pop.net.inputRow(0));
+        pop.net.feedForward(1, pop.genomes.data(), pop.genomeSize, nullptr);
+        applyControls(pop, 0, pop.net.outputRow(0));
+    }
+    updatePhysics(pop, 0);
+    checkCollision(pop, 0, world);
+    return true;
+}
+
+void printFlight(Population &pop, const World &world)
+{
+    calcFitness(pop, 0, world, world.startPos, experiment().lifetime);
+    std::cout << "Kroki: " << pop.timeAlive[0] << " | CP: " << pop.checkpointsVisited(0) << "/" << world.checkpointCount()
+              << " | Ukończona: " << (pop.completed[0] ? "tak" : "nie") << " | Fitness: " << (long)pop.fitness[0] << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string genomePath, mapPath;
+    bool render = false;
+    ExperimentConfig config;
+    for (int a = 1; a < argc; ++a)
+    {
+        std::string arg = argv[a];
+        if (arg == "--render")
+            render = true;
+        else if (arg == "--config" && a + 1 < argc)
+        {
+            if (!loadExperiment(argv[++a], config))
+                return 1;
+        }
+        else if (arg == "--set" && a + 1 < argc)
+        {
+            if (!applyExperimentOption(argv[++a], config))
+                return 1;
+        }
+        else if (genomePath.empty())
+            genomePath = arg;
+        else
+            mapPath = arg;
+    }
+    if (genomePath.empty())
+    {
+        std::cerr << "Użycie: replay <plik.genome> [tor] [--render] [--config plik.cfg] [--set klucz=wartość]" << std::endl;
+        return 1;
+    }
+
+    GenomeFile genome;
+    if (!loadGenome(genomePath, genome))
+        return 1;
+    if (genome.topology.size() >= 2)
+        config.hiddenLayers.assign(genome.topology.begin() + 1, genome.topology.end() - 1);
+    if (genome.laserCount != config.laserCount() || genome.topology != config.topology())
+    {
+        std::cerr << genomePath << ": genotyp nie pasuje do konfiguracji rakiety (lasery: " << genome.laserCount << ")" << std::endl;
+        return 1;
+    }
+    if (!validateExperiment(config, "konfiguracja"))
+        return 1;
+    setExperiment(config);
+    std::cout << "Genotyp z pokolenia " << genome.generation << ", fitness " << (long)genome.fitness
+              << ", wagi " << weightFormatName(genome.format) << std::endl;
+
+    World world = createWorld();
+    if (!mapPath.empty() && !loadMap(mapPath, world))
+        return 1;
+
+    Population pop;
+    pop.resize(1, genome.laserCount, genome.topology);
+    std::copy(genome.weights.begin(), genome.weights.end(), pop.genome(0));
+    pop.resetAll(world.startPos);
+
+    std::unique_ptr<RocketNetwork> fixedNet;
+    if (genome.topology == std::vector<int>(RocketNetwork::Topology.begin(), RocketNetwork::Topology.end()))
+    {
+        fixedNet = std::make_unique<RocketNetwork>();
+        fixedNet->setWeights(genome.weights);
+    }
+    std::cout << "Sieć: " << (fixedNet ? "FixedNetwork<13, 8, 3>" : "wsadowa (topologia z pliku)") << std::endl;
+
+    if (!render)
+    {
+        for (int timer = 0; timer <= experiment().lifetime; ++timer)
+            if (!replayStep(pop, world, fixedNet.get()))
+                break;
+        printFlight(pop, world);
+        return 0;
+    }
+
+    auto window = sf::RenderWindow(sf::VideoMode({(unsigned)world.width, (unsigned)world.height}), "Replay - Neural Network Rockets C++");
+    window.setFramerateLimit(200);
+
+    sf::Texture texture;
+    if (!texture.loadFromFile("../../src/img/rakieta.png"))
+        return -1;
+    sf::Texture fireTexture;
+    if (!fireTexture.loadFromFile("../../src/img/ogien.png"))
+        return -1;
+    Renderer renderer(world, texture, fireTexture);
+
+    RenderFrame frame;
+    int timer = 0;
+    while (window.isOpen())
+    {
+        while (const std::optional event = window.pollEvent())
+        {
+            if (event->is<sf::Event::Closed>())
+                window.close();
+        }
+
+        // koniec lotu - wynik i start od nowa
+        if (!replayStep(pop, world, fixedNet.get()) || ++timer > experiment().lifetime)
+        {
+            printFlight(pop, world);
+            pop.resetAll(world.startPos);
+            timer = 0;
+        }
+
+        window.clear(sf::Color::White);
+        renderer.drawWorld(window);
+        captureFrame(pop, frame, genome.generation, timer);
+        renderer.drawRockets(window, frame);
+        renderer.drawLasers(window, frame);
+        window.display();
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "BatchedNetwork.h"
+#include "FlatNetwork.h"
+
+#include <cmath>
+#include <utility>
+
+// Jedna warstwa dla wierszy [begin, end). NOut > 0 - liczba wyjść znana w czasie kompilacji; NOut == 0 - dowolna.
+// Kolejność działań w obu wersjach jest ta sama co w FlatNetwork::layerForward, więc wyniki są identyczne
+template <int NOut>
+static void layerRows(const Real *in, Real *out, int nIn, int nOut, int begin, int end, const Real *genomes, int genomeStride,
+                      int weightOffset, const int *ids)
+{
+    for (int r = begin; r < end; r++)
+    {
+        const int id = ids ? ids[r] : r;
+        const Real *w = genomes + (long long)id * genomeStride + weightOffset;
+        const Real *a = in + r * nIn;
+        if constexpr (NOut == 0)
+            FlatNetwork::layerForward(a, w, nIn, nOut, out + r * nOut);
+        else
+        {
+            Real acc[NOut] = {};
+            for (int i = 0; i < nIn; i++)
+            {
+                const Real av = a[i];
+                const Real *row = w + i * NOut;
+                for (int j = 0; j < NOut; j++)
+                    acc[j] += av * row[j];
+            }
+            Real *o = out + r * NOut;
+            for (int j = 0; j < NOut; j++)
+                o[j] = acc[j] / (Real(1) + std::fabs(acc[j]));
+        }
+    }
+}
+
+// Jądro dla warstwy o nOut wyjściach - z tablicy jąder 0..MAX_FIXED_OUTPUTS (0 = ogólne)
+template <int... N>
+static BatchedNetwork::LayerKernel selectKernel(int nOut, std::integer_sequence<int, N...>)
+{
+    static const BatchedNetwork::LayerKernel table[] = {layerRows<N>...};
+    return nOut < (int)sizeof...(N) ? table[nOut] : table[0];
+}
+
+// Konstruktor. Każda warstwa dostaje blok [maxBatch][rozmiar warstwy] w jednym buforze
+BatchedNetwork::BatchedNetwork(std::vector<int> topology, int maxBatch)
+{
+    this->topology = topology;
+    this->maxBatch = maxBatch;
+
+    int offset = 0;
+    for (int n : topology)
+    {
+        this->layerOffsets.push_back(offset);
+        offset += maxBatch * n;
+    }
+    this->activations.assign(offset, Real(0));
+
+    int w = 0;
+    for (size_t l = 0; l + 1 < topology.size(); l++)
+    {
+        this->weightOffsets.push_back(w);
+        this->kernels.push_back(selectKernel(topology[l + 1], std::make_integer_sequence<int, MAX_FIXED_OUTPUTS + 1>()));
+        w += topology[l] * topology[l + 1];
+    }
+}
+
+void BatchedNetwork::feedForward(int count, const Real *genomes, int genomeStride, const int *ids)
+{
+    this->feedForwardRange(0, count, genomes, genomeStride, ids);
+}
+
+// Warstwa po warstwie, a w środku wiersz po wierszu - wagi i wartości każdej warstwy leżą obok siebie,
+// więc całe jądro warstwy przechodzi po pamięci liniowo
+void BatchedNetwork::feedForwardRange(int begin, int end, const Real *genomes, int genomeStride, const int *ids)
+{
+    for (size_t l = 0; l + 1 < this->topology.size(); l++)
+    {
+        const Real *in = this->activations.data() + this->layerOffsets[l];
+        Real *out = this->activations.data() + this->layerOffsets[l + 1];
+        this->kernels[l](in, out, this->topology[l], this->topology[l + 1], begin, end, genomes, genomeStride, this->weightOffsets[l], ids);
+    }
+}
+
+// Mnożenie macierzy [count][nIn] x [nIn][nOut] w kolejności i-k-j - wiersz wag jest czytany raz
+// na cały wiersz partii, a wynik akumulowany liniowo
+void BatchedNetwork::feedForwardShared(int count, const Real *weights)
+{
+    for (size_t l = 0; l + 1 < this->topology.size(); l++)
+    {
+        const int nIn = this->topology[l];
+        const int nOut = this->topology[l + 1];
+        const Real *in = this->activations.data() + this->layerOffsets[l];
+        Real *out = this->activations.data() + this->layerOffsets[l + 1];
+        const Real *w = weights + this->weightOffsets[l];
+
+        for (int k = 0; k < count * nOut; k++)
+            out[k] = Real(0);
+        for (int r = 0; r < count; r++)
+        {
+            const Real *a = in + r * nIn;
+            Real *c = out + r * nOut;
+            for (int i = 0; i < nIn; i++)
+            {
+                const Real av = a[i];
+                const Real *row = w + i * nOut;
+                for (int j = 0; j < nOut; j++)
+                    c[j] += av * row[j];
+            }
+        }
+        // funkcja softsign
+        for (int k = 0; k < count * nOut; k++)
+            out[k] = out[k] / (Real(1) + std::fabs(out[k]));
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef CMAKESFMLPROJECT_BATCHED_NETWORK_H
+#define CMAKESFMLPROJECT_BATCHED_NETWORK_H
+
+#include <vector>
+
+#include "Precision.h"
+
+// największa liczba wyjść warstwy, dla której jest osobne jądro
+const int MAX_FIXED_OUTPUTS = 16;
+
+// Przejście w przód dla całej partii sieci naraz.
+// Wejścia wszystkich wierszy (np. żywych rakiet) są upakowane w macierz [partia][wejścia],
+// a każda warstwa liczona jest jednym jądrem dla całej partii:
+//  - feedForward()       - każdy wiersz ma własne wagi (wsadowe GEMV po genotypach z areny),
+//  - feedForwardShared() - jeden genotyp dla wszystkich wierszy (GEMM), np. ocena jednej sieci w wielu scenariuszach.
+// Bufory aktywacji są alokowane raz w konstruktorze, obliczenia nie alokują pamięci.
+// Topologia jest znana dopiero w czasie działania (konfiguracja eksperymentu), więc konstruktor wybiera dla każdej
+// warstwy jądro feedForward() skompilowane dla jej liczby wyjść (do MAX_FIXED_OUTPUTS) - akumulatory w rejestrach
+// i rozwinięta pętla wewnętrzna, jak w FixedNetwork; większe warstwy liczy jądro ogólne.
+// Genotypy i aktywacje są typu Real (double albo float, zob. Precision.h).
+class BatchedNetwork
+{
+public:
+    BatchedNetwork() : maxBatch(0) {}
+    BatchedNetwork(std::vector<int> topology, int maxBatch);
+
+    // Wiersz wejść / wyjść o numerze r
+    Real *inputRow(int r) { return this->activations.data() + r * this->topology.front(); }
+    const Real *outputRow(int r) const { return this->activations.data() + this->layerOffsets.back() + r * this->topology.back(); }
+
+    // genomes + ids[r] * genomeStride to wagi sieci dla wiersza r (ids == nullptr oznacza ids[r] = r)
+    void feedForward(int count, const Real *genomes, int genomeStride, const int *ids);
+    // Liczy tylko wiersze [begin, end) - pozwala dzielić partię między wątki
+    void feedForwardRange(int begin, int end, const Real *genomes, int genomeStride, const int *ids);
+
+    // Te same wagi dla wszystkich count wierszy
+    void feedForwardShared(int count, const Real *weights);
+
+    int getMaxBatch() const { return this->maxBatch; }
+    const std::vector<int> &getTopology() const { return this->topology; }
+
+    // Wiersze [begin, end) jednej warstwy: in/out - aktywacje warstwy, wagi wiersza r od genomes + ids[r] * genomeStride + weightOffset
+    using LayerKernel = void (*)(const Real *in, Real *out, int nIn, int nOut, int begin, int end, const Real *genomes, int genomeStride,
+                                 int weightOffset, const int *ids);
+
+private:
+    std::vector<int> topology;
+    int maxBatch;
+    std::vector<int> layerOffsets;  // początek warstwy l w buforze activations
+    std::vector<int> weightOffsets; // początek macierzy wag warstwy l w genotypie
+    std::vector<LayerKernel> kernels; // jądro warstwy l (wybrane według liczby wyjść)
+    std::vector<Real> activations;
+};
+
+#endif // CMAKESFMLPROJECT_BATCHED_NETWORK_H
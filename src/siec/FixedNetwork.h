@@ -0,0 +1,111 @@
+#ifndef CMAKESFMLPROJECT_FIXED_NETWORK_H
+#define CMAKESFMLPROJECT_FIXED_NETWORK_H
+
+#include <array>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include "../Random.h"
+#include "Precision.h"
+
+// Sieć o topologii znanej w czasie kompilacji, np. FixedNetwork<13, 8, 3>.
+// Wagi i wartości neuronów leżą w std::array, a rozmiary pętli są stałymi, więc kompilator
+// może całkowicie rozwinąć warstwy. Interfejs i układ wag są takie same jak w FlatNetwork
+// (kolejność NeuralNetwork::getWeights()), a kolejność sumowania ta sama, więc przy tych samych ustawieniach
+// kompilatora wyniki są identyczne. Wagi i aktywacje są typu Real (zob. Precision.h).
+template <int... Layers>
+class FixedNetwork
+{
+    static_assert(sizeof...(Layers) >= 2, "Sieć potrzebuje co najmniej warstwy wejściowej i wyjściowej");
+
+public:
+    static constexpr int LayerCount = (int)sizeof...(Layers);
+    static constexpr std::array<int, sizeof...(Layers)> Topology = {Layers...};
+
+    static constexpr int weightOffset(int layer)
+    {
+        int offset = 0;
+        for (int l = 0; l < layer; ++l)
+            offset += Topology[l] * Topology[l + 1];
+        return offset;
+    }
+
+    static constexpr int activationOffset(int layer)
+    {
+        int offset = 0;
+        for (int l = 0; l < layer; ++l)
+            offset += Topology[l];
+        return offset;
+    }
+
+    static constexpr int WeightCount = weightOffset(LayerCount - 1);
+    static constexpr int ActivationCount = activationOffset(LayerCount);
+    static constexpr int InputCount = Topology[0];
+    static constexpr int OutputCount = Topology[LayerCount - 1];
+
+    // Losuje wagi z zakresu od -1 do 1, tak jak FlatNetwork
+    FixedNetwork()
+    {
+        fillUniform(threadRng(), this->weights.data(), this->weights.size(), -1.0, 1.0);
+        this->activations.fill(Real(0));
+    }
+
+    Real *inputData() { return this->activations.data(); }
+    void setCurrentInput(const std::vector<double> &input)
+    {
+        int n = std::min((int)input.size(), InputCount);
+        std::copy(input.begin(), input.begin() + n, this->activations.begin());
+    }
+
+    void feedForward() { forwardFrom<0>(); }
+
+    const Real *outputData() const { return this->activations.data() + activationOffset(LayerCount - 1); }
+    std::vector<double> getOutputs() const { return std::vector<double>(outputData(), outputData() + OutputCount); }
+
+    std::vector<double> getWeights() const { return std::vector<double>(this->weights.begin(), this->weights.end()); }
+    // nadmiarowe wartości są pomijane, tak jak w FlatNetwork::setWeights
+    void setWeights(const std::vector<double> &weights)
+    {
+        size_t n = std::min(weights.size(), this->weights.size());
+        std::copy(weights.begin(), weights.begin() + n, this->weights.begin());
+    }
+    Real *weightData() { return this->weights.data(); }
+    const Real *weightData() const { return this->weights.data(); }
+    int getWeightCount() const { return WeightCount; }
+
+    std::vector<int> getTopology() const { return std::vector<int>(Topology.begin(), Topology.end()); }
+
+private:
+    // Warstwa o stałych wymiarach: out = softsign(in * W), ta sama kolejność działań co FlatNetwork::layerForward
+    template <int NIn, int NOut>
+    static void layerForward(const Real *in, const Real *w, Real *out)
+    {
+        Real acc[NOut] = {};
+        for (int i = 0; i < NIn; i++)
+        {
+            const Real a = in[i];
+            for (int j = 0; j < NOut; j++)
+                acc[j] += a * w[i * NOut + j];
+        }
+        for (int j = 0; j < NOut; j++)
+            out[j] = acc[j] / (Real(1) + std::fabs(acc[j]));
+    }
+
+    template <int L>
+    void forwardFrom()
+    {
+        if constexpr (L + 1 < LayerCount)
+        {
+            layerForward<Topology[L], Topology[L + 1]>(this->activations.data() + activationOffset(L),
+                                                       this->weights.data() + weightOffset(L),
+                                                       this->activations.data() + activationOffset(L + 1));
+            forwardFrom<L + 1>();
+        }
+    }
+
+    std::array<Real, WeightCount> weights;
+    std::array<Real, ActivationCount> activations;
+};
+
+#endif // CMAKESFMLPROJECT_FIXED_NETWORK_H
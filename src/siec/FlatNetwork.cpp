@@ -0,0 +1,99 @@
+#include "FlatNetwork.h"
+#include "../Random.h"
+
+#include <climits>
+#include <cmath>
+#include <algorithm>
+
+// Konstruktor sieci. Alokuje bufor wag (losowanych z zakresu od -1 do 1) oraz bufor wartości neuronów
+FlatNetwork::FlatNetwork(std::vector<int> topology)
+{
+    this->topology = topology;
+    this->weights.resize(weightCount(topology));
+    this->activations.assign(activationCount(topology), 0.0);
+    this->outputOffset = activationCount(topology) - topology.back();
+
+    fillUniform(threadRng(), this->weights.data(), this->weights.size(), -1.0, 1.0);
+}
+
+int FlatNetwork::weightCount(const std::vector<int> &topology)
+{
+    int count = 0;
+    for (size_t i = 0; i + 1 < topology.size(); i++)
+        count += topology[i] * topology[i + 1];
+    return count;
+}
+
+bool FlatNetwork::validTopology(const std::vector<int> &topology, long long maxWeights)
+{
+    if (topology.size() < 2)
+        return false;
+    maxWeights = std::min<long long>(maxWeights, INT_MAX);
+    long long weights = 0, neurons = 0;
+    for (size_t i = 0; i < topology.size(); i++)
+    {
+        if (topology[i] <= 0)
+            return false;
+        neurons += topology[i];
+        if (i + 1 < topology.size() && topology[i + 1] > 0)
+        {
+            weights += (long long)topology[i] * topology[i + 1];
+            if (weights > maxWeights)
+                return false;
+        }
+    }
+    return neurons <= INT_MAX;
+}
+
+int FlatNetwork::activationCount(const std::vector<int> &topology)
+{
+    int count = 0;
+    for (int n : topology)
+        count += n;
+    return count;
+}
+
+// Kopiuje dane wejściowe do pierwszej warstwy
+void FlatNetwork::setCurrentInput(const std::vector<double> &input)
+{
+    int n = std::min((int)input.size(), this->topology[0]);
+    std::copy(input.begin(), input.begin() + n, this->activations.begin());
+}
+
+void FlatNetwork::feedForward()
+{
+    forward(this->topology.data(), (int)this->topology.size(), this->weights.data(), this->activations.data());
+}
+
+// Dla każdej warstwy: out = softsign(in * W).
+// Warstwa wejściowa nie jest aktywowana - tak jak w NeuralNetwork::feedForward()
+void FlatNetwork::forward(const int *topology, int layerCount, const double *weights, double *activations)
+{
+    const double *in = activations;
+    double *out = activations + topology[0];
+    const double *w = weights;
+
+    for (int l = 0; l + 1 < layerCount; l++)
+    {
+        const int nIn = topology[l];
+        const int nOut = topology[l + 1];
+        layerForward(in, w, nIn, nOut, out);
+
+        w += nIn * nOut;
+        in = out;
+        out += nOut;
+    }
+}
+
+std::vector<double> FlatNetwork::getOutputs() const
+{
+    const double *o = this->outputData();
+    return std::vector<double>(o, o + this->topology.back());
+}
+
+// Wgrywa wagi z wektora do sieci (nadmiarowe wartości są pomijane, tak jak w NeuralNetwork::setWeights)
+void FlatNetwork::setWeights(const std::vector<double> &weights)
+{
+    size_t n = std::min(weights.size(), this->weights.size());
+    std::copy(weights.begin(), weights.begin() + n, this->weights.begin());
+}
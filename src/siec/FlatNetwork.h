@@ -0,0 +1,75 @@
+#ifndef CMAKESFMLPROJECT_FLAT_NETWORK_H
+#define CMAKESFMLPROJECT_FLAT_NETWORK_H
+
+#include <vector>
+#include <cmath>
+
+// Sieć neuronowa o płaskiej reprezentacji.
+// Wszystkie wagi leżą w jednym ciągłym buforze (warstwa po warstwie, macierz [wejście][wyjście] wierszami),
+// w tej samej kolejności co NeuralNetwork::getWeights(), więc genotypy obu klas są wymienne.
+// Wartości neuronów wszystkich warstw trzymane są we wstępnie zaalokowanym buforze,
+// dzięki czemu feedForward() nie wykonuje żadnych alokacji.
+class FlatNetwork
+{
+public:
+    FlatNetwork(std::vector<int> topology);
+
+    // Wejście można zapisać bezpośrednio do bufora (bez kopiowania wektora)
+    double *inputData() { return this->activations.data(); }
+    void setCurrentInput(const std::vector<double> &input);
+    void feedForward();
+
+    // Aktywowane wartości ostatniej warstwy (decyzje sieci)
+    const double *outputData() const { return this->activations.data() + this->outputOffset; }
+    std::vector<double> getOutputs() const;
+
+    std::vector<double> getWeights() const { return this->weights; }
+    void setWeights(const std::vector<double> &weights);
+    double *weightData() { return this->weights.data(); }
+    const double *weightData() const { return this->weights.data(); }
+    int getWeightCount() const { return (int)this->weights.size(); }
+
+    const std::vector<int> &getTopology() const { return this->topology; }
+
+    // Liczba wag sieci o danej topologii
+    static int weightCount(const std::vector<int> &topology);
+    // Liczba wartości neuronów wszystkich warstw (rozmiar bufora aktywacji)
+    static int activationCount(const std::vector<int> &topology);
+    // Czy topologia wczytana z pliku jest poprawna: co najmniej 2 warstwy, rozmiary > 0, najwyżej maxWeights wag
+    // (liczone bez przepełnienia int, więc potem można bezpiecznie wołać weightCount i activationCount)
+    static bool validTopology(const std::vector<int> &topology, long long maxWeights);
+
+    // Przejście w przód na surowych buforach. activations[0..topology[0]) to wejście,
+    // kolejne warstwy są dopisywane za nim, a ostatnia zawiera wyjście sieci
+    static void forward(const int *topology, int layerCount, const double *weights, double *activations);
+    // Jedna warstwa: out = softsign(in * W), W ma wymiary [nIn][nOut] (T = double lub float, zob. Precision.h)
+    template <class T>
+    static void layerForward(const T *in, const T *w, int nIn, int nOut, T *out);
+
+private:
+    std::vector<int> topology;
+    std::vector<double> weights;
+    std::vector<double> activations;
+    int outputOffset;
+};
+
+// Pętla wewnętrzna idzie po wierszu macierzy wag, więc dostęp do pamięci jest liniowy
+// i kompilator może ją zwektoryzować
+template <class T>
+void FlatNetwork::layerForward(const T *in, const T *w, int nIn, int nOut, T *out)
+{
+    for (int j = 0; j < nOut; j++)
+        out[j] = T(0);
+    for (int i = 0; i < nIn; i++)
+    {
+        const T a = in[i];
+        const T *row = w + i * nOut;
+        for (int j = 0; j < nOut; j++)
+            out[j] += a * row[j];
+    }
+    // funkcja softsign do sprowadzania wartosci do zakresu (-1,1)
+    for (int j = 0; j < nOut; j++)
+        out[j] = out[j] / (T(1) + std::fabs(out[j]));
+}
+
+#endif // CMAKESFMLPROJECT_FLAT_NETWORK_H
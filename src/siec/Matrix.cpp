@@ -1,36 +1,23 @@
 #include "Matrix.h"
 
-#include <random>
+#include "../Random.h"
 
-// Generuje losową liczbę zmiennoprzecinkową z zakresu od -1 do 1
+// Generuje losową liczbę zmiennoprzecinkową z zakresu od -1 do 1 (generator wątku, bez std::random_device na każdą wagę)
 double Matrix::generateRandomNumber()
 {
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<> dis(-1.0, 1.0);
-
-    return dis(gen);
+    return threadRng().range(-1.0, 1.0);
 }
 
-// Konstruktor macierzy. Alokuje pamięć dla wektora dwuwymiarowego o zadanych wymiarach
+// Konstruktor macierzy. Alokuje ciągły bufor o zadanych wymiarach
 Matrix::Matrix(int numRows, int numCols, bool isRandom)
 {
     this->numRows = numRows;
     this->numCols = numCols;
+    this->isRandom = isRandom;
 
-    for (int i = 0; i < numRows; i++)
+    this->values.assign(numRows * numCols, 0.00);
+    if (isRandom)
     {
-        std::vector<double> colValues;
-
-        for (int j = 0; j < numCols; j++)
-        {
-            double r = 0.00;
-            if (isRandom)
-            {
-                r = this->generateRandomNumber();
-            }
-            colValues.push_back(r);
-        }
-        this->values.push_back(colValues);
+        fillUniform(threadRng(), this->values.data(), this->values.size(), -1.0, 1.0);
     }
-}
\ No newline at end of file
+}
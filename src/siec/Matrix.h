@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include <vector>
+#include <assert.h>
 
 class Matrix
 {
@@ -10,15 +11,20 @@ public:
     Matrix(int numRows, int numCols, bool isRandom);
     double generateRandomNumber();
 
+    // Wartości przechowywane są w jednym ciągłym buforze (wiersz po wierszu)
     void setValue(int r, int c, double v)
     {
-        this->values.at(r).at(c) = v;
+        assert(r >= 0 && r < this->numRows && c >= 0 && c < this->numCols);
+        this->values[r * this->numCols + c] = v;
     };
     double getValue(int r, int c)
     {
-        return this->values.at(r).at(c);
+        assert(r >= 0 && r < this->numRows && c >= 0 && c < this->numCols);
+        return this->values[r * this->numCols + c];
     };
 
+    double *data() { return this->values.data(); }
+
     int getNumRows() { return this->numRows; }
     int getNumCols() { return this->numCols; }
 
@@ -26,7 +32,7 @@ private:
     int numRows;
     int numCols;
     bool isRandom;
-    std::vector<std::vector<double>> values;
+    std::vector<double> values;
 };
 
 #endif // CMAKESFMLPROJECT_MATRIX_H
\ No newline at end of file
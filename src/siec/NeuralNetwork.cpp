@@ -29,7 +29,8 @@ void NeuralNetwork::feedForward()
         }
 
         Matrix *b = this->getWeightMatrix(i);
-        Matrix *c = (new utils::MultiplyMatrix(a, b))->execute();
+        utils::MultiplyMatrix multiply(a, b);
+        Matrix *c = multiply.execute();
 
         // Sprzątanie po macierzy a (jeśli była alokowana dynamicznie w pętli)
         delete a;
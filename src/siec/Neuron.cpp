@@ -17,5 +17,5 @@ Neuron::Neuron(double value)
 // funkcja softsign do sprowadzania wartosci do zakresu (-1,1)
 void Neuron::activate()
 {
-    this->activatedValue = this->value / (1 + abs(this->value));
+    this->activatedValue = this->value / (1 + std::fabs(this->value));
 }
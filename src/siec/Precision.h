@@ -0,0 +1,15 @@
+#ifndef CMAKESFMLPROJECT_PRECISION_H
+#define CMAKESFMLPROJECT_PRECISION_H
+
+// Typ liczb w genotypach i sieciach używanych przez symulację (BatchedNetwork, FixedNetwork).
+// Domyślnie double; opcja CMake ROCKETS_FLOAT32 przełącza na float - dwa razy mniej pamięci na genotypy
+// i aktywacje oraz dwa razy szersze wektory SIMD. Fizyka i czujniki zawsze liczą we float,
+// a wejścia sieci, fitness i statystyki w double (tryb mieszany).
+// NeuralNetwork i FlatNetwork zostają w double jako implementacje referencyjne.
+#ifdef ROCKETS_FLOAT32
+using Real = float;
+#else
+using Real = double;
+#endif
+
+#endif // CMAKESFMLPROJECT_PRECISION_H
@@ -15,20 +15,27 @@ utils::MultiplyMatrix::MultiplyMatrix(Matrix *a, Matrix *b)
     this->c = new Matrix(a->getNumRows(), b->getNumCols(), false);
 }
 
-// Wykonuje właściwe mnożenie macierzy (wiersze razy kolumny) i zwraca wskaźnik do nowo utworzonej macierzy wynikowej
+// Wykonuje właściwe mnożenie macierzy (wiersze razy kolumny) i zwraca wskaźnik do nowo utworzonej macierzy wynikowej.
+// Właścicielem wyniku jest wywołujący. Kolejność pętli i-k-j przechodzi po wierszach B liniowo
 Matrix *utils::MultiplyMatrix::execute()
 {
-    for (int i = 0; i < a->getNumRows(); i++)
+    const int n = a->getNumRows();
+    const int m = b->getNumCols();
+    const int inner = b->getNumRows();
+    const double *pa = this->a->data();
+    const double *pb = this->b->data();
+    double *pc = this->c->data();
+
+    for (int i = 0; i < n; i++)
     {
-        for (int j = 0; j < b->getNumCols(); j++)
+        for (int k = 0; k < inner; k++)
         {
-            for (int k = 0; k < b->getNumRows(); k++)
-            {
-                double p = this->a->getValue(i, k) * this->b->getValue(k, j);
-                double newVal = this->c->getValue(i, j) + p;
-                this->c->setValue(i, j, newVal);
-            }
+            const double av = pa[i * inner + k];
+            const double *rowB = pb + k * m;
+            double *rowC = pc + i * m;
+            for (int j = 0; j < m; j++)
+                rowC[j] += av * rowB[j];
         }
     }
     return this->c;
-}
\ No newline at end of file
+}